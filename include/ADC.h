@@ -7,12 +7,19 @@
 #include <GlobalTools.h>
 #include <GlobalDefs.h>
 #include <DMA.h>
+#include <ADCRing.h>
+#include <SYS.h>
 
 class ADCModule;
 struct ADCPeripheral;
 
 typedef void ADCWindowCallback(void);
 
+typedef void (*ADCCaptureCallback)(ADCModule &source);
+
+typedef void (*ADCStreamCallback)(ADCModule &source, uint16_t *block, int16_t sampleCount,
+  int16_t blockIndex);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> ADC MODULE CLASS
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -25,6 +32,8 @@ class ADCModule {
     int16_t descriptorIndex); 
   friend void dataDMACallback (DMA_CALLBACK_REASON reason, TransferChannel &source, 
     int16_t descriptorIndex); 
+  friend void splitDMACallback (DMA_CALLBACK_REASON reason, TransferChannel &source, 
+    int16_t descriptorIndex); 
 
   public:
     const uint8_t moduleNumber;
@@ -47,6 +56,50 @@ class ADCModule {
 
     void flushBuffer();
 
+    int16_t getStableHalf();
+
+    uint32_t getBlockCount();
+
+    float getSampleRate();
+
+    uint32_t samplesAvailable();
+
+    uint32_t peekSamples(uint16_t *&samples);
+
+    void commitSamples(uint32_t sampleCount);
+
+    uint32_t getOverruns();
+
+    ADC_CAPTURE_STATE getCaptureState();
+
+    bool rearmCapture();
+
+    uint32_t readCapture(uint16_t *destination, uint32_t maxSamples);
+
+    uint32_t getCaptureLength();
+
+    uint16_t *getBlock(int16_t blockIndex);
+
+    int16_t getBlockLength();
+
+    uint16_t *getPinBlock(int16_t pinIndex);
+
+    int16_t getPinBlockLength();
+
+    bool getSplitEnabled();
+
+    uint32_t getSplitDrops();
+
+    bool holdBlock(int16_t blockIndex);
+
+    bool releaseBlock(int16_t blockIndex);
+
+    uint32_t getStalls();
+
+    uint32_t getStallMicros();
+
+    uint32_t getSamplesLost();
+
     bool syncBusy();
 
     ~ADCModule();
@@ -60,6 +113,23 @@ class ADCModule {
       
       ADCSettings &setAutoStopConfig(bool enabled, uint16_t transferCount);
 
+      ADCSettings &setStreamConfig(bool enableStreaming, ADCStreamCallback callback = nullptr);
+
+      ADCSettings &setCaptureConfig(bool enableCapture, uint32_t preSamples, 
+        uint32_t postSamples, ADCCaptureCallback callback = nullptr);
+
+      ADCSettings &setSplitConfig(bool splitByPin);
+
+      ADCSettings &setTimerTrigger(int16_t timer);
+
+      ADCSettings &setSampleRate(float hz);
+
+      ADCSettings &setPairConfig(bool pairWithADC0, bool interleave = false);
+
+      ADCSettings &setBuffer(uint16_t *buffer, uint32_t sampleCount);
+
+      ADCSettings &setBufferLength(uint32_t sampleCount);
+
       ADCSettings &setPrescaler(uint8_t clockDivisor);
 
       ADCSettings &setSleepConfig(bool runWhileSleep);
@@ -107,16 +177,34 @@ class ADCModule {
     Adc *adc;
     TransferChannel *dataChannel;
     TransferChannel *ctrlChannel;
+    TransferChannel *splitChannel;
     uint8_t dataChNum;
     uint8_t ctrlChNum;
     TransferDescriptor dataDesc;
     TransferDescriptor ctrlDesc;
+    TransferDescriptor streamDesc[ADC_STREAM_DESC_COUNT];
+    TransferDescriptor splitDesc[ADC_SPLIT_MAX_PINS];
+    TransferDescriptor captureDesc[ADC_CAPTURE_DESC_COUNT];
     uint32_t ctrlInput[ADC_MAX_PINS];
     uint16_t *DB;
+    uint16_t *splitDB;
+    ADCBlockQueue streamQueue;        // Stable blocks for the reader
+    volatile bool stalled;            // DMAC suspended on a held block
+    volatile uint32_t stallStart;     // micros() when it did
+    volatile uint32_t stallCount;
+    volatile uint32_t stallMicros;
+    volatile uint32_t samplesLost;    // Estimated, timer paced only
 
     volatile int16_t ctrlIndex;
     volatile int16_t DBIndex;
     volatile int16_t currentState = 0;
+    volatile int16_t stableHalf;
+    volatile uint32_t blockCount;
+    volatile int16_t splitHalf;
+    volatile uint32_t splitDrops;     // Blocks skipped, previous split still running
+    volatile ADC_CAPTURE_STATE captureState;
+    volatile uint32_t triggerIndex;   // DB index of the sample that set off the window
+    volatile int16_t stopSegment;
 
 
     //// FIELDS ////
@@ -128,7 +216,7 @@ class ADCModule {
     //// SETTINGS ////
     uint8_t priorityLvl;
     uint16_t dataTransferSize;
-    int16_t DBLength;
+    uint32_t DBLength;
     ADCWindowCallback *windowCB;
     int8_t erChannel; // External reference, disabled if negative
     uint8_t erType;
@@ -139,6 +227,18 @@ class ADCModule {
     bool cDestCorrect;
     uint16_t autoStopTC;
     bool autoStopEnabled;
+    bool streamEnabled;
+    ADCStreamCallback streamCB;
+    bool captureEnabled;
+    uint32_t capturePre;
+    uint32_t capturePost;
+    ADCCaptureCallback captureCB;
+    bool splitEnabled;
+    int16_t triggerTimer;   // Conversions started by this timer's overflow, free running if -1
+    int16_t triggerEvent;   // EVSYS channel while enabled
+    bool ownsTimer;         // Timer allocated by setSampleRate (vs shared, see setTimerTrigger)
+    bool pairEnabled;       // ADC1 only -> slaved to ADC0, converts on ADC0's start
+    bool pairInterleaved;   // ADC1 samples land between ADC0's in ADC0's buffer
 
     void resetFields();
 
@@ -150,9 +250,35 @@ class ADCModule {
 
     bool setDescDefault();
 
+    bool initStream();
+
+    bool initSplit();
+
+    bool startSplit(int16_t half);
+
     bool enableExternalRef();
 
     void disableExternalRef();
+
+    bool initTimerTrigger();
+
+    void exitTimerTrigger();
+
+    void freeTimer();
+
+    bool initBuffer(uint16_t *buffer, uint32_t sampleCount);
+
+    bool initPair();
+
+    void exitPair();
+
+    int16_t getStreamStride();
+
+    bool initCapture();
+
+    void exitCapture();
+
+    void triggerCapture();
 };
 
 
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> ADC RING
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Parts of the ADC's buffer handling that touch no ADC register -> the same code runs against
+// the DMAC model in the native env (see src/bench)
+
+#pragma once
+#include <Arduino.h>
+#include <GlobalDefs.h>
+#include <RingBuffer.h>
+#include <DMA.h>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> STREAM BLOCK QUEUE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Blocks of the stream ring the DMAC finished, oldest first. ISR side takes them from the
+// writeback (collect()), so a late ISR or one TCMPL for several blocks still queues every block.
+// Reader side reads samples in place from the buffer, nothing is copied.
+// Note -> one ISR & one reader, neither masks interrupts (RingBuffer)
+class ADCBlockQueue {
+  public:
+
+    ADCBlockQueue();
+
+    void reset(uint16_t *buffer, int16_t blockLength);
+
+    //// ISR SIDE ////
+    int16_t collect(TransferChannel &source);
+
+    //// READER SIDE ////
+    uint32_t samplesAvailable();
+
+    uint32_t peekSamples(uint16_t *&samples);
+
+    void commitSamples(uint32_t sampleCount);
+
+    uint32_t getOverruns();
+
+  private:
+    RingBuffer<int16_t, ADC_BLOCK_QUEUE_LENGTH> blocks;
+    uint16_t *buffer;
+    int16_t blockLength;
+    int16_t cursor;                   // Oldest block not handed out yet (nextCompleted)
+    uint32_t readOffset;              // Samples of the oldest queued block already read
+    volatile uint32_t overruns;       // Samples the reader lost (DMAC lapped it)
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> CAPTURE STOP
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Where a capture ring of ADC_CAPTURE_DESC_COUNT segments stops once the window fires
+struct ADCCaptureStop {
+  uint32_t triggerIndex;            // Buffer index of the sample that set off the window
+  int16_t stopSegment;              // Segment to suspend after (holds the last post sample)
+};
+
+bool ADCFindCaptureStop(int16_t activeSegment, uint32_t remaining, uint32_t length,
+  uint32_t postSamples, ADCCaptureStop &stop);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> SINGLE SHOT BUFFER
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Points the single shot descriptor @ buffer & copies it onto the channel (not bound -> desc
+// may be rebuilt at will, call again to apply). False if desc is invalid or the channel refused.
+bool ADCLoadBuffer(TransferChannel &channel, TransferDescriptor &desc, uint16_t *buffer,
+  uint16_t transferSize);
@@ -3,6 +3,7 @@
 #include<Arduino.h>
 #include <GlobalDefs.h>
 #include <GlobalTools.h>
+#include <COMQueue.h>
 
 typedef void (*COMCallback)(uint8_t callbackReason);
 
@@ -20,6 +21,15 @@ class COM_ : public USBDeviceClass {
     bool end(); 
 
     bool sendPackets(void *source, uint16_t numPackets); 
+    bool sendPackets(void *source, uint16_t numPackets, COMSendCallback releaseCallback);
+
+    bool enqueue(void *source, uint16_t numBytes, COMSendCallback releaseCallback = nullptr,
+      bool endTransfer = true);
+    bool enqueue(const COMSendEntry *entries, int16_t count);
+
+    int16_t queueSpace();
+
+    int16_t queueCount();
 
     bool sendBusy();
 
@@ -29,6 +39,10 @@ class COM_ : public USBDeviceClass {
 
     bool abortSend();
 
+    int16_t readPacket(uint8_t *&packet);
+
+    bool releasePacket();
+
     int16_t recievePackets(void *destination, uint16_t numPackets, bool forceRecieve); 
 
     uint8_t *inspectPacket(uint16_t packetIndex); 
@@ -41,6 +55,8 @@ class COM_ : public USBDeviceClass {
 
     int16_t packetsRecieved(); 
 
+    int16_t customBytesRecieved();
+
     bool requestPending();
 
     void cancelRequest(); 
@@ -66,6 +82,8 @@ class COM_ : public USBDeviceClass {
 
       COMSettings &setEnforceNumPacketConfig(bool enforceNumPackets);
 
+      COMSettings &setAutoZLPConfig(bool enableAutoZLP);
+
       void setDefault();
 
       private:
@@ -85,6 +103,14 @@ class COM_ : public USBDeviceClass {
 
     void resetSize(int16_t endpoint);
 
+    void armNext();
+
+    void commitRX();
+
+    void armRX();
+
+    void armBank(void *destination, uint16_t numBytes);
+
   private:
     //// Fields ////
     friend COMSettings;
@@ -95,16 +121,19 @@ class COM_ : public USBDeviceClass {
     Timeout otherTO;
 
     //// Variables ////
-    uint8_t RX[COM_RX_SIZE];
-    volatile int16_t RXi; // Packet index
-    volatile int16_t rxiLast;
-    volatile bool rxiActive;
+    COMReceiveRing rxRing;
+    volatile bool rxArmed;      // Ring recieve enabled
+    volatile bool rxStalled;    // Ring full -> bank not armed
+    void *volatile rxCustom;    // One shot destination (if pending)
+    volatile uint16_t rxCustomBytes;
     volatile ERROR_ID currentError;
     bool begun;
+    COMSendQueue sendQueue;
     
     //// Settings ////
     COMCallback *callback;
     bool enforceNumPackets;
+    bool autoZLP;
     uint8_t cbrMask;
     uint32_t STOtime;
     uint32_t OTOtime;
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> COM SEND QUEUE & RECEIVE RING
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <Arduino.h>
+#include <GlobalDefs.h>
+
+typedef void (*COMSendCallback)(void *source);
+
+struct COMSendEntry {
+  void *source;
+  uint16_t numBytes;
+  COMSendCallback releaseCB;
+  bool endTransfer;
+};
+
+// What goes on the IN bank next (ADDR, BYTE_COUNT & whether the host transfer ends w it)
+struct COMSendSpan {
+  const uint8_t *address;
+  uint16_t numBytes;
+  bool endTransfer;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> COM SEND QUEUE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Scheduling half of the COM_ send path, no hardware access -> same code runs against the
+// endpoint model in the native env. Entries are handed out as spans (next()), one span is on
+// the endpoint at a time & entries are only given back (release()) once the endpoint is done.
+// Entries that do not end a transfer are gathered into full packets -> only the last packet of
+// a transfer can be short (a short packet ends the host's transfer). Whole packets go out
+// straight from the entry, only the bytes around entry boundaries are copied (stage).
+// Note -> not interrupt safe on its own, COM_ calls it w interrupts masked or from its ISR
+class COMSendQueue {
+  public:
+
+    COMSendQueue();
+
+    bool push(const COMSendEntry &entry);
+
+    bool next(COMSendSpan &span);
+
+    void complete();
+
+    bool release(COMSendEntry &entry);
+
+    void abort();
+
+    int16_t space();
+
+    int16_t count();
+
+    bool busy();
+
+    bool isArmed();
+
+    void reset();
+
+  private:
+    COMSendEntry entries[COM_SEND_QUEUE_LENGTH];
+    volatile uint8_t head;      // Next free slot (written by push)
+    volatile uint8_t tail;      // Next entry to hand out
+    volatile uint8_t done;      // Oldest entry not yet released
+    volatile uint8_t ready;     // Entries before this one may be released
+    volatile bool armed;        // Span from next() is on the endpoint
+    uint8_t armedTail;          // Tail once the armed span is done
+    uint16_t offset;            // Bytes of the entry @ tail already handed out
+
+    //// Packet gather ////
+    __attribute__((__aligned__(4))) uint8_t stage[COM_PACKET_SIZE];
+    uint16_t stageFill;
+    bool armedStage;            // Span on the endpoint is the stage
+
+    bool handOut(uint16_t count);
+
+    bool arm(COMSendSpan &span, const uint8_t *address, uint16_t numBytes, bool endTransfer);
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> COM RECEIVE RING
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Packet slots the OUT bank is armed on in turn, one packet per slot. Free running uint8
+// indices -> head - tail is the packet count. Slot @ head is the one on the endpoint.
+// Note -> ISR writes head (commit), reader writes tail (release), flush() needs both masked
+class COMReceiveRing {
+  public:
+
+    COMReceiveRing();
+
+    uint8_t *armSlot();
+
+    void commit(uint16_t numBytes);
+
+    int16_t read(uint8_t *&packet);
+
+    bool release();
+
+    int16_t flush(int16_t numPackets);
+
+    uint8_t *inspect(uint16_t packetIndex);
+
+    int16_t available(bool packets);
+
+    void reset();
+
+  private:
+    __attribute__((__aligned__(4))) uint8_t data[COM_RX_SIZE];
+    uint16_t lengths[COM_RX_PACKETS];
+    volatile uint8_t head;      // Written by ISR (commit)
+    volatile uint8_t tail;      // Written by reader (release)
+};
+
+// Queues entries on the IN endpoint, all or none -> COM_::enqueue() on the device, the endpoint
+// model glue in the native env. Lets hardware free code (FRAME) send w/o the COM_ class.
+bool COMEnqueue(const COMSendEntry *entries, int16_t count);
@@ -1,7 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> DAC
+///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
-#include<Arduino.h>
-#include<DMA.h>
-#include<GlobalDefs.h>
+#include <Arduino.h>
+#include <GlobalDefs.h>
+#include <DMA.h>
+#include <SYS.h>
+#include <ADC.h>
 
-// Digital Analog Converter
+class DACModule;
+
+typedef void (*DACRefillCallback)(DACModule &source, uint16_t *block, int16_t sampleCount,
+  int16_t blockIndex);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DAC MODULE CLASS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// One DAC channel (DAC0 -> A0, DAC1 -> A1) fed by DMA & paced by a TC overflow -> no CPU per
+// sample. Waveform mode loops one buffer as is, stream mode plays two halves & hands the one
+// just played to the refill callback while the other plays.
+class DACModule {
+  struct DACSettings;
+  friend DACModule::DACSettings;
+  friend void DACDMACallback(DMA_CALLBACK_REASON reason, TransferChannel &source,
+    int16_t descriptorIndex);
+
+  public:
+    const uint8_t channelNumber;
+
+    DACModule(uint8_t channelNum);
+
+    bool begin();
+
+    void end();
+
+    bool setWaveform(const uint16_t *samples, uint16_t sampleCount);
+
+    bool setStream(uint16_t *buffer, uint32_t sampleCount, DACRefillCallback callback);
+
+    bool start();
+
+    void stop();
+
+    bool startCapture(ADCModule &capture);  // Capture lags stimulus by DAC_CAPTURE_LAG samples
+
+    void stopCapture(ADCModule &capture);
+
+    bool isRunning();
+
+    bool write(uint16_t value);
+
+    float getSampleRate();
+
+    uint16_t *getBlock(int16_t blockIndex);
+
+    int16_t getBlockLength();
+
+    uint32_t getBlockCount();
+
+    int16_t getTimer();
+
+    ERROR_ID getError();
+
+    ~DACModule();
+
+    struct DACSettings {
+
+      DACSettings &setSampleRate(float hz);
+
+      DACSettings &setReference(DAC_REFERENCE reference);
+
+      DACSettings &setDitherConfig(bool enableDither);
+
+      DACSettings &setStandbyConfig(bool runWhileStandby);
+
+      DACSettings &setPriorityClass(DMA_PRIORITY_CLASS priorityClass);
+
+      void setDefault();
+
+    private:
+      friend DACModule;
+      DACModule *super;
+      explicit DACSettings(DACModule *super);
+  }settings{this};
+
+  protected:
+    //// IMPORTANT ////
+    Dac *dac;
+    TransferChannel *channel;
+    int16_t timer;
+    TransferDescriptor desc[DAC_STREAM_DESC_COUNT];
+
+    volatile int16_t currentState = 0;
+    volatile uint32_t blockCount;
+    int16_t nextBlock;                // Oldest block not handed to refillCB yet (nextCompleted)
+
+    //// FIELDS ////
+    DAC_MODE mode;
+    const uint16_t *waveform;
+    uint16_t *streamBuffer;
+    uint32_t bufferLength;
+    DACRefillCallback refillCB;
+    ERROR_ID currentError;
+
+    //// SETTINGS ////
+    float sampleRate;             // Requested -> actual is the timer's
+    DAC_REFERENCE reference;
+    bool dither;
+    bool runStandby;
+    DMA_PRIORITY_CLASS priorityClass;
+
+    void resetFields();
+
+    bool initDAC();
+
+    void exitDAC();
+
+    bool initDMA();
+
+    void exitDMA();
+};
@@ -11,7 +11,63 @@ class TransferDescriptor;
 typedef void (*DMACallbackFunction)(DMA_CALLBACK_REASON reason, TransferChannel &source, 
 int16_t descriptorIndex);
 
-typedef void (*ChecksumCallback)(ERROR_ID error, int16_t bytesWritten);
+typedef void (*DMAChannelISR)(TransferChannel &channel);
+
+// Note -> cycles are measured from DMAC vector entry to the channel callback (DWT CYCCNT)
+struct DMAChannelStats {
+  uint32_t blocksCompleted;
+  uint32_t bytesMoved;
+  uint32_t suspends;
+  uint32_t errors;
+  uint32_t interrupts;
+  uint32_t callbacks;
+  uint32_t callbackCycles;      // Last
+  uint32_t callbackCyclesMax;
+  uint32_t callbackCyclesTotal; // Average -> total / callbacks
+};
+
+// Identifies one copyAsync/fillAsync job -> slot is reused, generation tells jobs apart
+struct DMAHandle {
+  int16_t slot;           // -1 if job was not started
+  uint16_t generation;
+};
+
+typedef void (*DMAAsyncCallback)(DMAHandle handle, ERROR_ID error);
+
+// What a subsystem needs from a channel -> allocator picks level, channel & checks bandwidth
+struct DMAChannelRequest {
+  int16_t ownerID;
+  DMA_SUBSYSTEM subsystem;
+  DMA_PRIORITY_CLASS priorityClass;
+  DMA_TRIGGER trigger;
+  uint32_t bytesPerSecond;        // Expected peak (0 if negligible)
+  bool eventOutput;               // Generates events (channels 0 - 3 only)
+  bool eventInput;                // Takes events (channels 0 - 7 only)
+};
+
+struct DMAChannelUsage {
+  int16_t channelIndex;
+  bool allocated;
+  DMA_SUBSYSTEM reservedFor;
+  DMAChannelRequest request;      // Valid if allocated
+  uint8_t priorityLevel;          // Current arbitration level (may be changed after alloc)
+};
+
+// Beat, burst & threshold for one move -> from DMAUtility::tune() or benchmarkTuning()
+struct DMATuning {
+  int16_t beatSize;               // Bytes (1, 2 or 4)
+  int16_t burstLength;            // Beats per bus grant (1 - 16)
+  int16_t threshold;              // Beats read before the write starts (1, 2, 4 or 8)
+  DMA_TRIGGER_ACTION triggerAction;
+};
+
+struct DMATuningResult {
+  DMATuning tuning;
+  uint32_t cycles;                // Trigger to completion callback (CYCCNT)
+  float bytesPerMicro;
+};
+
+typedef void (*ChecksumCallback)(ChecksumGen &source, ERROR_ID error, uint32_t checksum);
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> DMA UTILITY
@@ -19,12 +75,46 @@ typedef void (*ChecksumCallback)(ERROR_ID error, int16_t bytesWritten);
 
 class DMAUtility {
   private:
+    friend TransferChannel;
+    friend void dispatch(int16_t channelIndex);
     DMAUtility() {}
     static TransferChannel channelArray[DMA_MAX_CHANNELS];
     static bool begun;
     static int16_t currentChannel;
 
+    //// Descriptor pool ////
+    static int16_t poolNext[DMA_POOL_SIZE];       // Free list links (pool index)
+    static int16_t poolHead;                      // First free (-1 if pool empty)
+    static int16_t poolUsage[DMA_MAX_CHANNELS];
+    static bool poolReady;
+
+    static DmacDescriptor *allocDescriptor(int16_t channelIndex);
+
+    static void freeDescriptor(DmacDescriptor *descriptor, int16_t channelIndex);
+
+    //// Async copy ////
+    friend void asyncIRQHandler(DMA_CALLBACK_REASON reason, TransferChannel &source,
+      int16_t descriptorIndex);
+    struct AsyncSlot {
+      TransferChannel *channel;     // Allocated on first use & kept
+      uint32_t pattern;             // Fill source word
+      DMAAsyncCallback callback;
+      volatile uint16_t generation;
+      volatile bool busy;
+      volatile ERROR_ID error;
+    };
+    static AsyncSlot asyncSlots[DMA_ASYNC_SLOTS];
+
+    //// Allocator ////
+    static DMA_SUBSYSTEM reservedFor[DMA_MAX_CHANNELS];
+    static DMAChannelRequest channelRequest[DMA_MAX_CHANNELS];
+    static uint32_t bandwidthUsed;
+
+    static DMAHandle startAsync(void *destination, const void *source, uint32_t numBytes, 
+      bool fill, uint8_t fillValue, DMAAsyncCallback callback);
+
   public:
+      static DMAUtility instance;   // Backs DMA
 
       void begin();
 
@@ -36,12 +126,47 @@ class DMAUtility {
 
       TransferChannel *allocateChannel();
       TransferChannel *allocateChannel(int16_t ownerID);
+      static TransferChannel *allocateChannel(const DMAChannelRequest &request);
+
+      static int16_t reserveChannels(DMA_SUBSYSTEM subsystem, int16_t count);
+
+      static void releaseReservation(DMA_SUBSYSTEM subsystem);
+
+      static int16_t getUtilization(DMAChannelUsage *table, int16_t tableSize);
+
+      static uint32_t bandwidthFree();
 
       void freeChannel(int16_t channelIndex);
       void freeChannel(TransferChannel *channel);
 
       void resetChannel(int16_t channelIndex);
       void resetChannel(TransferChannel *channel);
+
+      int16_t descriptorsFree();
+
+      int16_t descriptorsUsed(int16_t channelIndex);
+
+      static bool getStats(int16_t channelIndex, DMAChannelStats &snapshot);
+
+      static void clearStats();
+
+      static DMAHandle copyAsync(void *destination, const void *source, uint32_t numBytes,
+        DMAAsyncCallback callback = nullptr);
+
+      static DMAHandle fillAsync(void *destination, uint8_t value, uint32_t numBytes,
+        DMAAsyncCallback callback = nullptr);
+
+      static bool isDone(DMAHandle handle);
+
+      static bool wait(DMAHandle handle, uint32_t timeout);
+
+      static ERROR_ID asyncError(DMAHandle handle);
+
+      static DMATuning tune(uint32_t source, uint32_t destination, uint32_t numBytes,
+        int16_t peripheralBeat = 0);
+
+      static int16_t benchmarkTuning(void *destination, const void *source, uint16_t numBytes,
+        DMATuningResult *results, int16_t maxResults);
 };
 extern DMAUtility &DMA;
 
@@ -80,6 +205,8 @@ class TransferDescriptor {
 
     TransferDescriptor &setAction(DMA_TRANSFER_ACTION action);
 
+    TransferDescriptor &setEventOutput(DMA_EVENT_OUTPUT output);
+
     void setDefault();
 
     bool isBindable();
@@ -110,6 +237,8 @@ class TransferChannel {
 
     bool setDescriptor(TransferDescriptor *descriptor, bool bindDescriptor);
 
+    bool setDescriptorChain(DmacDescriptor *chain, int16_t count);
+
     bool replaceDescriptor(TransferDescriptor *updatedDescriptor, int16_t descriptorIndex,
       bool bindDescriptor);
 
@@ -136,6 +265,14 @@ class TransferChannel {
 
     bool queue(int16_t descriptorIndex);
 
+    bool beginUpdate();
+
+    bool endUpdate();
+
+    bool isUpdating();
+
+    bool updateDescriptor(TransferDescriptor *updatedDescriptor, int16_t descriptorIndex);
+
     bool enableExternalTrigger();
 
     bool disableExternalTrigger();
@@ -150,8 +287,14 @@ class TransferChannel {
 
     bool getDescriptorValid(int16_t descriptoerIndex);
 
+    bool setDescriptorAction(int16_t descriptorIndex, DMA_TRANSFER_ACTION action);
+
     int16_t getLastIndex();
 
+    int16_t getActiveIndex();
+
+    int16_t nextCompleted(int16_t &cursor);
+
     int16_t remainingBytes();
 
     int16_t remainingBursts();
@@ -172,6 +315,16 @@ class TransferChannel {
 
     uint8_t getChannelNum();
 
+    bool isAllocated();
+
+    const DmacDescriptor *descriptor(int16_t descriptorIndex);
+
+    int16_t getDescriptorCount();
+
+    bool getStats(DMAChannelStats &snapshot);
+
+    void clearStats();
+
     struct TransferSettings {
       
         TransferSettings &setTransferThreshold(int16_t elements);
@@ -180,6 +333,8 @@ class TransferChannel {
 
         TransferSettings &setTriggerAction(DMA_TRIGGER_ACTION action);
 
+        TransferSettings &setTuning(const DMATuning &tuning);
+
         TransferSettings &setStandbyConfig(bool enabledDurringStandby);
 
         TransferSettings &setPriorityLevel(int16_t priorityLevel);
@@ -197,6 +352,10 @@ class TransferChannel {
 
         void removeExternalTrigger();
 
+        TransferSettings &setEventOutput(DMA_EVENT_OUTPUT output);
+
+        TransferSettings &setEventInput(DMA_EVENT_ACTION action);
+
         void setDefault();
 
         void equals(TransferChannel &other);
@@ -210,15 +369,15 @@ class TransferChannel {
 
     private:
 
-      friend void DMAC_0_Handler(void);
+      friend void channelISR(TransferChannel &channel);
+      friend void invokeCallback(TransferChannel &channel, DMA_CALLBACK_REASON reason);
       friend ChecksumGen;
       friend DMAUtility;
 
       //// GENERL FIELDS ////
       int16_t descriptorCount;
       TransferDescriptor *boundPrimary;
-      int16_t previousIndex;              // For iteration optimization
-      DmacDescriptor *previousDescriptor; // For iteration optimization
+      DmacDescriptor *descriptorTable[DMA_MAX_CHAIN_LENGTH]; // Index -> descriptor (chain order)
 
       //// DMA UTIL VALUES //// 
       bool allocated;
@@ -233,6 +392,8 @@ class TransferChannel {
       volatile bool suspendFlag;
       volatile int16_t currentDescriptor;
       uint8_t syncStatus;
+      bool updating;                      // Live update in progress (channel held suspended)
+      bool updateResume;                  // Resume on endUpdate (channel was running)
 
       ///// SETTINGS ////
       DMA_TRIGGER externalTrigger;
@@ -242,6 +403,9 @@ class TransferChannel {
       bool transferCompleteCallbacks;
       bool suspendCallbacks;
 
+      //// STATS ////
+      DMAChannelStats stats;
+
       TransferChannel(int16_t channelIndex);
 
     protected:
@@ -255,6 +419,8 @@ class TransferChannel {
       void loopDescriptors(bool updateWriteback);
 
       void  unloopDescriptors(bool updateWriteback);
+
+      void syncCurrentDescriptor();
     
       void clearDescriptors();
 };
@@ -263,18 +429,27 @@ class TransferChannel {
 ///// SECTION -> CHECKSUM CHANNEL
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Runs the DMAC CRC engine over data moved by its own channel -> no CPU byte loops. Engine is
+// shared, so only one ChecksumGen can run at a time.
 class ChecksumGen {
   public:
     const int16_t ownerID;
 
     ChecksumGen(int16_t ownerID);
 
+    bool begin();
+
     bool start(int16_t checksumLength);
+    bool start(const void *data, uint32_t length);
 
     bool stop(bool hardStop);
 
     bool isBusy();
 
+    uint32_t getChecksum();
+
+    bool selfTest();
+
     int16_t remainingBytes();
 
     ERROR_ID getError();
@@ -291,7 +466,7 @@ class ChecksumGen {
 
       ChecksumSettings &setStandbyConfig(bool enabledDurringStandby);
 
-      ChecksumSettings &setCallbackFunction(ChecksumCallback *callbackFunc);
+      ChecksumSettings &setCallbackFunction(ChecksumCallback callbackFunc);
 
       ChecksumSettings &setPriorityLevel(int16_t priorityLvl);
 
@@ -311,16 +486,128 @@ class ChecksumGen {
     friend void ChecksumIRQHandler(DMA_CALLBACK_REASON reason, TransferChannel &source, 
       int16_t descriptorIndex);
 
+    static ChecksumGen *engineOwner;  // Gen currently using the CRC engine
+
     TransferChannel *channel;
-    TransferDescriptor writeDesc;
-    TransferDescriptor readDesc;
-    ChecksumCallback *callback; 
+    TransferDescriptor desc;
+    ChecksumCallback callback; 
     int16_t uniqueID;
+    uint32_t sourceAddr;
+    uint32_t destAddr;                // 0 -> data is discarded into sink
+    uint32_t sink;
   
   protected:
-    bool descValid;
-    volatile int16_t remainingCycles;
+    volatile bool busy;
+    volatile uint32_t checksum;
     bool mode32;
 
     void init();
+
+    void release();
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> SOFTWARE CHECKSUM
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Bit exact reference of the DMAC CRC engine (host decoders & checking hardware results)
+uint16_t softCRC16(const void *data, uint32_t length, uint16_t crc = CHECKSUM_CRC16_INIT);
+
+uint32_t softCRC32(const void *data, uint32_t length, uint32_t crc = CHECKSUM_CRC32_INIT);
+
+uint32_t softCRC32Final(uint32_t crc);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> STATIC DESCRIPTOR CHAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// One block of a fixed pipeline -> BTCTRL, BTCNT & address spans are compile time constants, 
+// invalid beat/count/step combinations fail to build. Same meaning as the TransferDescriptor 
+// setters (StepSize is the STEPSIZE register value, X1 = 0).
+template<int16_t BeatSize, uint16_t Beats, bool SourceInc = true, bool DestinationInc = true,
+  DMA_TRANSFER_ACTION Action = ACTION_NONE, DMA_TARGET StepTarget = SOURCE, int16_t StepSize = 0,
+  DMA_EVENT_OUTPUT EventOutput = EVENT_OUTPUT_NONE>
+struct StaticDescriptor {
+  static_assert(BeatSize == 1 || BeatSize == 2 || BeatSize == 4, "Beat size must be 1, 2 or 4");
+  static_assert(Beats > 0, "Block needs at least one beat");
+  static_assert(StepSize >= 0 && StepSize <= 7, "Step size is X1 - X128 (0 - 7)");
+  static_assert(StepSize == 0 || (StepTarget == SOURCE ? SourceInc : DestinationInc),
+    "Step size only applies to an incrementing address");
+
+  static constexpr int16_t beatSize = BeatSize;
+  static constexpr uint16_t beats = Beats;
+  static constexpr uint32_t bytes = (uint32_t)Beats * BeatSize;
+
+  static constexpr uint16_t btctrl = DMAC_BTCTRL_VALID
+    | ((uint16_t)EventOutput << DMAC_BTCTRL_EVOSEL_Pos)
+    | ((uint16_t)Action << DMAC_BTCTRL_BLOCKACT_Pos)
+    | ((uint16_t)(BeatSize >> 1) << DMAC_BTCTRL_BEATSIZE_Pos)
+    | ((uint16_t)SourceInc << DMAC_BTCTRL_SRCINC_Pos)
+    | ((uint16_t)DestinationInc << DMAC_BTCTRL_DSTINC_Pos)
+    | ((uint16_t)(StepTarget == SOURCE) << DMAC_BTCTRL_STEPSEL_Pos)
+    | ((uint16_t)StepSize << DMAC_BTCTRL_STEPSIZE_Pos);
+
+  // DMAC takes end addresses -> start + span
+  static constexpr uint32_t sourceSpan = !SourceInc ? 0 
+    : bytes * (StepTarget == SOURCE ? (1ul << StepSize) : 1);
+  static constexpr uint32_t destinationSpan = !DestinationInc ? 0 
+    : bytes * (StepTarget == DESTINATION ? (1ul << StepSize) : 1);
+};
+
+template<int16_t Index, typename First, typename... Rest> struct StaticStage {
+  using type = typename StaticStage<Index - 1, Rest...>::type;
+};
+template<typename First, typename... Rest> struct StaticStage<0, First, Rest...> {
+  using type = First;
+};
+
+// Fixed chain of StaticDescriptors built in place -> setAddresses() only adds the start 
+// addresses (alignment checked from the pointer types), attach() links it to a channel w/o 
+// allocating or validating. Must outlive its channel's use of it (static storage).
+//
+// e.g. StaticChain<StaticDescriptor<2, 256, false, true, ACTION_BLOCK_INTERRUPT>> chain;
+//      chain.setAddresses<0>(&ADC0->RESULT.reg, samples);
+//      chain.attach(*channel);
+template<typename... Stages> class StaticChain {
+  static constexpr int16_t count = sizeof...(Stages);
+  static_assert(count > 0 && count <= DMA_MAX_CHAIN_LENGTH, "Chain length out of range");
+
+  public:
+    StaticChain() {
+      static constexpr uint16_t btctrl[] = { Stages::btctrl... };
+      static constexpr uint16_t beats[] = { Stages::beats... };
+      for (int16_t i = 0; i < count; i++) {
+        chain[i].BTCTRL.reg = btctrl[i];
+        chain[i].BTCNT.reg = beats[i];
+        chain[i].SRCADDR.reg = 0;
+        chain[i].DSTADDR.reg = 0;
+        chain[i].DESCADDR.reg = 0;
+      }
+    }
+
+    // Pointer types must be at least as wide as the beat -> alignment holds by construction
+    template<int16_t Index, typename S, typename D>
+    StaticChain &setAddresses(const volatile S *source, volatile D *destination) {
+      static_assert(Index >= 0 && Index < count, "Stage index out of range");
+      using Stage = typename StaticStage<Index, Stages...>::type;
+      static_assert(alignof(S) >= Stage::beatSize, "Source type narrower than the beat");
+      static_assert(alignof(D) >= Stage::beatSize, "Destination type narrower than the beat");
+
+      chain[Index].SRCADDR.reg = (uint32_t)source + Stage::sourceSpan;
+      chain[Index].DSTADDR.reg = (uint32_t)destination + Stage::destinationSpan;
+      return *this;
+    }
+
+    // Note -> every stage needs its addresses first, nothing else is checked here
+    bool attach(TransferChannel &channel) {
+      for (int16_t i = 0; i < count; i++) {
+        if (chain[i].SRCADDR.reg == 0 || chain[i].DSTADDR.reg == 0) return false;
+      }
+      return channel.setDescriptorChain(chain, count);
+    }
+
+    static constexpr int16_t length() { return count; }
+
+  private:
+    __attribute__((__aligned__(16))) DmacDescriptor chain[count];
 };
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> FRAME (TELEMETRY PROTOCOL)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <Arduino.h>
+#include <GlobalDefs.h>
+#include <DMA.h>
+#include <COMQueue.h>
+
+class FrameEncoder;
+class FrameDecoder;
+
+struct __attribute__((__packed__)) FrameHeader {
+  uint16_t sync;
+  uint8_t streamID;
+  uint8_t flags;
+  uint32_t sequence;
+  uint32_t timestamp;       // Micros @ frame start
+  uint16_t payloadLength;   // Bytes
+  uint16_t headerCRC;       // CRC16 over the fields above
+};
+static_assert(sizeof(FrameHeader) == FRAME_HEADER_SIZE, "Frame header must be packed");
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> FRAME ENCODER (DEVICE)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Wraps payloads in a header & CRC trailer. Payload is not copied by send() -> header, payload
+// & trailer go out as 3 COM queue entries of one transfer, which the queue packs into full
+// packets (only the last packet of a frame is short).
+class FrameEncoder {
+  public:
+    const uint8_t streamID;
+
+    FrameEncoder(uint8_t streamID, CRC_MODE mode = FRAME_DEFAULT_CRC_MODE);
+
+    bool send(void *payload, uint16_t payloadLength, COMSendCallback releaseCallback = nullptr);
+
+    bool sendWithCRC(void *payload, uint16_t payloadLength, uint32_t payloadCRC, 
+      COMSendCallback releaseCallback = nullptr);
+
+    int32_t encode(const void *payload, uint16_t payloadLength, uint8_t *dest, uint32_t destSize);
+
+    void setCRC(CRC_MODE mode);
+
+    CRC_MODE getCRC();
+
+    uint32_t getSequence();
+
+    void resetSequence();
+
+    ERROR_ID getError();
+
+  protected:
+
+    struct FrameSlot {
+      FrameHeader header;
+      uint32_t trailer;
+    };
+    __attribute__((__aligned__(4))) FrameSlot slots[FRAME_SLOT_COUNT];
+    uint8_t slotIndex;
+    uint32_t sequence;
+    CRC_MODE crcMode;
+    volatile ERROR_ID currentError;
+
+    void writeHeader(FrameHeader &header, uint16_t payloadLength);
+
+    uint32_t payloadCRC(const void *payload, uint16_t payloadLength);
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> FRAME DECODER (REFERENCE)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Byte stream decoder, no hardware access -> same code runs on the host. Resyncs on the sync
+// word & counts sequence gaps per stream.
+class FrameDecoder {
+  public:
+
+    FrameDecoder(uint8_t *buffer, uint32_t bufferSize);
+
+    uint32_t push(const void *data, uint32_t length);
+
+    bool available();
+
+    const FrameHeader *getHeader();
+
+    const uint8_t *getPayload();
+
+    bool getPayloadValid();
+
+    void next();
+
+    void reset();
+
+    uint32_t framesDecoded();
+
+    uint32_t headerErrors();
+
+    uint32_t payloadErrors();
+
+    uint32_t sequenceGaps();
+
+    uint32_t framesLost();
+
+    uint32_t bytesSkipped();
+
+  private:
+    uint8_t *buffer;
+    uint32_t bufferSize;
+    uint32_t fill;
+    uint32_t frameBytes;  // Size of frame @ buffer start (if available)
+    bool frameReady;
+    bool payloadValid;
+
+    //// Sequence tracking ////
+    uint32_t lastSequence[FRAME_MAX_STREAMS];
+    bool streamSeen[FRAME_MAX_STREAMS];
+
+    //// Stats ////
+    uint32_t decodedCount;
+    uint32_t headerErrorCount;
+    uint32_t payloadErrorCount;
+    uint32_t gapCount;
+    uint32_t lostCount;
+    uint32_t skippedCount;
+
+    void parse();
+
+    void drop(uint32_t count);
+
+    void trackSequence(const FrameHeader &header);
+};
@@ -32,6 +32,8 @@
 #define BOARD_ADC_PERIPH 1
 #define BOARD_ADC_MODULE_COUNT 2
 #define BOARD_ADC_IRQ_COUNT 2
+#define BOARD_DAC_PERIPH 1
+#define BOARD_DAC_CHANNEL_COUNT 2
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> GLOBAL TOOLS
@@ -69,6 +71,8 @@ enum ERROR_ID : uint8_t {
   ERROR_DMA_TRANSFER,
   ERROR_DMA_CRC,
   ERROR_DMA_DESCRIPTOR,
+  ERROR_DMA_UPDATE,
+  ERROR_DMA_EVENT,
 
   ERROR_COM_TIMEOUT,
   ERROR_COM_REQ,
@@ -79,7 +83,13 @@ enum ERROR_ID : uint8_t {
 
   ERROR_ADC_SYS,
   ERROR_ADC_DMA,
-  ERROR_ADC_EXREF
+  ERROR_ADC_EXREF,
+  ERROR_ADC_TRIGGER,
+  ERROR_ADC_PAIR,
+
+  ERROR_DAC_SYS,
+  ERROR_DAC_DMA,
+  ERROR_DAC_TIMER
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -88,11 +98,27 @@ enum ERROR_ID : uint8_t {
 
 //// DMA OTHER SETTINGS ////
 #define DMA_MAX_DESCRIPTORS 5
+#define DMA_MAX_CHAIN_LENGTH 16         // Descriptors per channel (index table size)
 #define DMA_MAX_CHANNELS 16
 #define DMA_PRIORITY_LVL_COUNT 4
 #define DMA_IRQ_COUNT 5
+#define DMA_SHARED_IRQ_MASK 0xFFFFFFF0ul // Channels on DMAC_4 line (0 - 3 have their own)
+#define DMA_ISR_MAX_PASSES 4            // Drain passes per DMAC_4 entry
+#define DMA_STATS_ENABLED true          // Per channel counters & ISR latency (DWT CYCCNT)
+#define DMA_UPDATE_SPIN_LIMIT 256       // Max polls for a live update suspend to land
+#define DMA_MAX_BEATS 65535             // BTCNT is 16 bits
+#define DMA_ASYNC_SLOTS 2               // Concurrent copyAsync/fillAsync jobs (one channel each)
+#define DMA_BANDWIDTH_BUDGET 48000000ul // Bytes/sec all allocator requests may claim
+#define DMA_TUNING_MAX_BURST 16         // BURSTLEN max (beats)
+#define DMA_TUNING_MAX_THRESHOLD 8      // THRESHOLD max (beats)
+#define DMA_TUNING_TIMEOUT 10000        // Micros per benchmark run
+#define DMA_RESERVED_ADC 4              // Channels 0 - 3 (own IRQ vectors) held for ADC, event
+                                        // requests borrow the highest free one if none left
+#define DMA_EVENT_OUTPUT_CHANNELS 4     // Only channels 0 - 3 generate events
+#define DMA_EVENT_INPUT_CHANNELS 8      // Only channels 0 - 7 take events
 #define DMA_DESCRIPTOR_VALID_COUNT 3
 #define DMA_MAX_CHECKSUM 2
+#define DMA_POOL_SIZE (DMA_MAX_DESCRIPTORS * DMA_MAX_CHANNELS) // Linked descriptors (all channels)
 
 //// DMA DEFAULT DESCRIPTOR SETTINGS ////
 #define DMA_DEFAULT_DATA_SIZE DMAC_BTCTRL_BEATSIZE_BYTE_Val
@@ -114,23 +140,23 @@ enum ERROR_ID : uint8_t {
 #define DMA_DEFAULT_PRIORITY_LVL 1
 
 //// CHECKSUM CHANNEL ////
-#define CHECKSUM_MAX_TRANSFER_AMOUNT 4
-
+#define CHECKSUM_MAX_BEATS 65535         // BTCNT is 16 bits
+#define CHECKSUM_CRCSRC_CHANNEL 0x20     // CRCSRC value of DMA channel 0 (channel n -> 0x20 + n)
+#define CHECKSUM_TEST_LENGTH 64          // Self test vector (bytes, word multiple)
+#define CHECKSUM_TEST_TIMEOUT 2000       // Micros
 
 //// CHECKSUM CHANNEL SETTINGS ////
-#define CHECKSUM_DEFAULT_DATASIZE 1
 #define CHECKSUM_DEFAULT_SLEEPCONFIG false
-#define CHECKSUM_READDESC_DEFAULT_TRANSFER_ACTION ACTION_SUSPEND
-#define CHECKSUM_WRITEDESC_DEFAULT_TRANSFER_ACTION ACTION_NONE
-#define CHECKSUM_DEFAULT_TRANSFER_AMOUNT 4
-#define CHECKSUM_READDESC_REQUIRED_SOURCE DMAC->CRCCHKSUM.reg
-#define CHECKSUM_WRITEDESC_REQUIRED_DESTINATION DMAC->CRCDATAIN.reg
-#define CHECKSUM_READDESC_REQUIRED_CORRECT_SOURCEADDR false
-#define CHECKSUM_WRITEDESC_REQUIRED_CORRECT_DESTADDR false
-#define CHECKSUM_REQUIRED_INCREMENT_CONFIG_SOURCE true
-#define CHECKSUM_REQUIRED_INCREMENT_CONFIG_DESTINATION true
+#define CHECKSUM_DEFAULT_PRIORITY_LVL 0
 #define CHECKSUM_DEFAULT_CHECKSUM32 false
 
+//// CHECKSUM ALGORITHMS (MATCH DMAC CRC ENGINE) ////
+#define CHECKSUM_CRC16_POLY 0x1021          // CRC-16/CCITT (MSB first)
+#define CHECKSUM_CRC16_INIT 0xFFFF
+#define CHECKSUM_CRC32_POLY 0xEDB88320ul    // CRC-32/IEEE 802.3 (reflected)
+#define CHECKSUM_CRC32_INIT 0xFFFFFFFFul
+#define CHECKSUM_CRC32_XOROUT 0xFFFFFFFFul
+
 //// ENUMS ////
 enum DMA_TARGET : uint8_t {
   SOURCE,
@@ -147,6 +173,21 @@ enum DMA_TRIGGER_ACTION : uint8_t {
   ACTION_TRANSFER_BURST = 2,
   ACTION_TRANSFER_ALL = 3
 };
+enum DMA_EVENT_OUTPUT : uint8_t {
+  EVENT_OUTPUT_NONE = 0,
+  EVENT_OUTPUT_BLOCK = 1,
+  EVENT_OUTPUT_BURST = 3
+};
+enum DMA_EVENT_ACTION : uint8_t {
+  EVENT_ACTION_NONE = 0,
+  EVENT_ACTION_TRIGGER = 1,
+  EVENT_ACTION_CONDITIONAL_TRIGGER = 2,
+  EVENT_ACTION_CONDITIONAL_BLOCK = 3,
+  EVENT_ACTION_SUSPEND = 4,
+  EVENT_ACTION_RESUME = 5,
+  EVENT_ACTION_SKIP = 6,
+  EVENT_ACTION_INCREASE_PRIORITY = 7
+};
 enum DMA_STATUS : uint8_t {
   DMA_CHANNEL_BUSY,
   DMA_CHANNEL_SUSPENDED,
@@ -252,6 +293,21 @@ enum CRC_MODE : uint8_t {
   CRC_16 = 0,
   CRC_32 = 1
 };
+enum DMA_PRIORITY_CLASS : uint8_t {   // Maps straight to arbitration level (3 wins)
+  CLASS_BACKGROUND = 0,
+  CLASS_NORMAL = 1,
+  CLASS_HIGH = 2,
+  CLASS_REALTIME = 3
+};
+enum DMA_SUBSYSTEM : uint8_t {
+  SUBSYSTEM_NONE = 0,
+  SUBSYSTEM_USER = 1,
+  SUBSYSTEM_ADC = 2,
+  SUBSYSTEM_SIO = 3,
+  SUBSYSTEM_CHECKSUM = 4,
+  SUBSYSTEM_ASYNC = 5,
+  SUBSYSTEM_DAC = 6
+};
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> SIO
@@ -322,9 +378,18 @@ enum I2C_STATUS : uint8_t {
 #define ADC_DEFAULT_MODULE ADC0
 #define ADC_DEFAULT_MODULE_NUM 0
 
-#define ADC_DB_LENGTH 512
+#define ADC_DB_LENGTH 512               // Default, carved from the arena @ begin()
+#define ADC_MAX_DB_LENGTH 65532         // setBuffer -> stream blocks fit int16 & divide it
+#define ADC_ARENA_LENGTH 16384          // Samples (32 KB), both modules -> caps setBufferLength
+#define ADC_ARENA_SLOTS 4               // Data + split buffer per module
 #define ADC_DB_INCREMENT 124
 #define ADC_DEFAULT_DB_OVERCLEAR 32
+#define ADC_STREAM_DESC_COUNT 4         // Stream blocks -> a held block leaves the DMAC 3 to fill
+#define ADC_BLOCK_QUEUE_LENGTH 8        // Power of two >= ADC_STREAM_DESC_COUNT
+#define ADC_DB_ALIGNMENT 64
+#define ADC_SPLIT_MAX_PINS 8            // Split stride is a STEPSIZE power of two (X1 - X8)
+#define ADC_CAPTURE_DESC_COUNT 8        // Capture ring segments -> stop lands on a segment end
+#define ADC_CAPTURE_MARGIN 4            // Samples left in a segment before its successor is "fetched"
 
 //// ADC SETTINGS ////
 #define ADC_CLOCK_DIVISOR_MAX ADC_CTRLA_PRESCALER_DIV256_Val
@@ -334,14 +399,20 @@ enum I2C_STATUS : uint8_t {
 #define ADC_GAINCORR_MAX_VAL 4095
 #define ADC_OFFCORR_MAX_VAL 4095
 #define ADC_PRIORITY_LVL_MAX_VAL 3
-#define ADC_DATA_TRANSFER_MAX_SIZE 64
 
 #define ADC_CLOCK_DIVISOR_DEFAULT 5
 #define ADC_DEFAULT_RESOLUTION 0
 #define ADC_DEFAULT_RESOLUTION_VAL 12
 #define ADC_DEFAULT_PRIORITY_LVL 1
+#define ADC_DMA_BANDWIDTH 2000000ul     // Bytes/sec of data channel @ max rate (1 MSPS, 16 bit)
 #define ADC_DEFAULT_DATA_TRANSFER_SIZE 16
 #define ADC_DEFAULT_DEST_CORRECT false
+#define ADC_DEFAULT_STREAM_ENABLED false
+#define ADC_DEFAULT_SPLIT_ENABLED false
+#define ADC_DEFAULT_TRIGGER_TIMER -1    // Free running
+#define ADC_MAX_SAMPLE_RATE 1000000ul   // 1 MSPS
+#define ADC_DEFAULT_PAIR_ENABLED false
+#define ADC_DEFAULT_CAPTURE_ENABLED false
 
 
 
@@ -358,6 +429,13 @@ enum ADC_WINDOW_MODE : uint8_t {
   WINDOW_MODE_RESULT_NOT_BOUNDED = 4
 };
 
+enum ADC_CAPTURE_STATE : uint8_t {
+  CAPTURE_IDLE,
+  CAPTURE_ARMED,                  // Filling pre trigger history, waiting on the window
+  CAPTURE_TRIGGERED,              // Stop segment set, DMAC collecting post trigger samples
+  CAPTURE_DONE                    // Channel suspended, capture frozen until rearmCapture()
+};
+
 enum ADC_REFERENCE : uint8_t {
   REFERENCE_INTERNAL        = 0,
   REFERENCE_VCC_HALF        = 2,
@@ -367,14 +445,49 @@ enum ADC_REFERENCE : uint8_t {
   REFERENCE_EXTERNAL_INPUT3 = 6
 };
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DAC
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//// DAC SYS ////
+#define DAC_GCLK_GENERATOR GCLK_PCHCTRL_GEN_GCLK4_Val // 12 MHz (DAC max)
+#define DAC_MAX_VALUE 4095
+#define DAC_MAX_SAMPLE_RATE 1000000ul   // 1 MSPS
+#define DAC_STREAM_DESC_COUNT 2
+#define DAC_MAX_WAVEFORM_LENGTH 65535   // One block (BTCNT)
+#define DAC_DMA_BANDWIDTH 2000000ul     // Bytes/sec of DMA channel @ max rate (1 MSPS, 16 bit)
+#define DAC_CAPTURE_LAG 1               // Capture sample k sees stimulus k - lag (see startCapture)
+
+//// DAC SETTINGS ////
+#define DAC_DEFAULT_SAMPLE_RATE 10000
+#define DAC_DEFAULT_REFERENCE DAC_REFERENCE_VDDANA
+#define DAC_DEFAULT_PRIORITY_CLASS CLASS_HIGH
+#define DAC_DEFAULT_DITHER false
+#define DAC_DEFAULT_RUN_STANDBY false
+
+enum DAC_REFERENCE : uint8_t {
+  DAC_REFERENCE_EXTERNAL          = 0,  // VREFA unbuffered
+  DAC_REFERENCE_VDDANA            = 1,
+  DAC_REFERENCE_EXTERNAL_BUFFERED = 2,
+  DAC_REFERENCE_INTERNAL          = 3
+};
+
+enum DAC_MODE : uint8_t {
+  DAC_MODE_NONE,
+  DAC_MODE_WAVEFORM,              // One buffer looped as is
+  DAC_MODE_STREAM                 // Double buffered halves, refilled by callback
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> COM CLASS
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #define COM_PACKET_SIZE 64
-#define COM_SEND_MAX_PACKETS 16
-#define COM_RX_SIZE 512
-#define COM_RX_PACKETS 8
+#define COM_SEND_MAX_PACKETS 255 // BYTE_COUNT is 14 bits
+#define COM_SEND_FRAMES 4 // Frames the send queue holds (FRAME_SEND_ENTRIES entries each)
+#define COM_SEND_QUEUE_LENGTH (COM_SEND_FRAMES * FRAME_SEND_ENTRIES + 1) // + 1 -> full != empty
+#define COM_RX_PACKETS 8 // Must divide 256 (free running uint8 ring indices)
+#define COM_RX_SIZE (COM_RX_PACKETS * COM_PACKET_SIZE)
 #define COM_DEFAULT_REQ 1
 #define COM_DEFAULT_RECIEVE 1
 
@@ -403,6 +516,7 @@ enum ADC_REFERENCE : uint8_t {
 #define COM_DEFAULT_SQ 0
 #define COM_DEFAULT_TIMEOUT 500
 #define COM_DEFAULT_ENFORCE_NUM 0
+#define COM_DEFAULT_AUTO_ZLP 1
 #define COM_DEFAULT_CALLBACK nullptr
 #define COM_DEFAULT_CBRMASK (                                \
     (COM_DEFAULT_RECEIVE_READY << COM_REASON_RECEIVE_READY)  \
@@ -412,5 +526,56 @@ enum ADC_REFERENCE : uint8_t {
   | (COM_DEFAULT_RESET << COM_REASON_RESET)                  \
   | (COM_DEFAULT_SOF << COM_REASON_SOF))
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> FRAME (TELEMETRY PROTOCOL)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//// FRAME FORMAT (LITTLE ENDIAN) ////
+// [sync:2][stream:1][flags:1][sequence:4][timestamp:4][length:2][headerCRC:2] [payload] [CRC:4]
+#define FRAME_SYNC_WORD 0xA55A
+#define FRAME_HEADER_SIZE 16
+#define FRAME_HEADER_CRC_SPAN 14 // Header bytes covered by headerCRC
+#define FRAME_TRAILER_SIZE 4     // CRC16 is zero extended -> keeps frames word aligned
+#define FRAME_OVERHEAD (FRAME_HEADER_SIZE + FRAME_TRAILER_SIZE)
+#define FRAME_MAX_PAYLOAD (COM_SEND_MAX_PACKETS * COM_PACKET_SIZE)
+#define FRAME_FLAG_CRC32 0x01
+
+//// ENCODER ////
+#define FRAME_SLOT_COUNT (COM_SEND_FRAMES + 1) // Header/trailer slots, + 1 -> a refused send never
+                                               // rewrites a slot still on the queue
+#define FRAME_SEND_ENTRIES 3     // COM queue entries per frame (header, payload, trailer)
+#define FRAME_DEFAULT_CRC_MODE CRC_16
+
+//// DECODER ////
+#define FRAME_MAX_STREAMS 16     // Streams tracked for sequence gaps
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DATA PIPELINE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define PIPE_DEFAULT_STREAM_ID 0
+#define PIPE_CHECKSUM_OWNER_ID 0
+#define PIPE_STATS_STREAM_ID 15      // Frame stream used by DMA stats dumps
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> SYSTEM
+///////////////////////////////////////////////////////////////////////////////////////////////////
 
+//// EVENT UTILITY ////
+#define EVNT_CHANNEL_COUNT 32
+#define EVNT_USER_COUNT 67
+#define EVNT_DMAC_GENERATOR EVSYS_ID_GEN_DMAC_CH_0  // + channel index (0 - 3)
+#define EVNT_DMAC_USER EVSYS_ID_USER_DMAC_CH_0      // + channel index (0 - 7)
 
+//// TIMER UTILITY ////
+#define TIM_TIMER_COUNT 4                           // TC0 - TC3 used as pacing timers
+#define TIM_GCLK_GENERATOR GCLK_PCHCTRL_GEN_GCLK1_Val
+#define TIM_CLOCK_HZ 48000000ul                     // GCLK1
+#define TIM_MAX_PERIOD 65536                        // 16 bit counter
+
+//// ENUMS ////
+enum EVENT_PATH : uint8_t {
+  EVENT_PATH_SYNC = 0,
+  EVENT_PATH_RESYNC = 1,
+  EVENT_PATH_ASYNC = 2
+};
@@ -6,6 +6,7 @@
 #include <Reset.h>
 #include <inttypes.h>
 #include <GlobalDefs.h>
+#include <RingBuffer.h>
 
 // IF EITHER = TRUE, APP IS ERASED ON RESET
 // FORCED BY EITHER ASSERT OR RAM ERROR
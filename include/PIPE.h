@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> DATA PIPELINE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <Arduino.h>
+#include <GlobalDefs.h>
+#include <ADC.h>
+#include <COM.h>
+#include <DMA.h>
+#include <FRAME.h>
+
+class StreamPipe;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> STREAM PIPE (ADC -> USB)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Hands completed ADC stream blocks straight to the USB endpoint (no copy) as frames. A block is
+// held (descriptor invalid) while the CRC engine & USB read it & only recycled on send complete.
+// CRC of block N runs on the DMAC while block N - 1 is still going out over USB.
+// Note -> source must not be in split mode (begin fails). If USB is still on a block when the
+// DMAC comes back round to it the stream stalls & samples are lost (source->getSamplesLost()).
+class StreamPipe {
+  public:
+
+    StreamPipe(uint8_t streamID = PIPE_DEFAULT_STREAM_ID);
+
+    bool begin(ADCModule *source, CRC_MODE mode = FRAME_DEFAULT_CRC_MODE);
+
+    void end();
+
+    bool isActive();
+
+    uint32_t blocksSent();
+
+    uint32_t blocksDropped();
+
+    bool hardwareCRC();
+
+    ERROR_ID getError();
+
+    ~StreamPipe();
+
+  private:
+    friend void pipeStreamCallback(ADCModule &source, uint16_t *block, int16_t sampleCount,
+      int16_t blockIndex);
+    friend void pipeSendCallback(void *source);
+    friend void pipeCRCCallback(ChecksumGen &source, ERROR_ID error, uint32_t checksum);
+
+    ADCModule *source;
+    uint16_t *blockPtr[ADC_STREAM_DESC_COUNT];
+    uint16_t blockPackets;
+    FrameEncoder framer;
+    ChecksumGen crc;
+    bool hwCRC;                     // Engine passed self test -> else software CRC
+
+    //// CRC stage ////
+    volatile int16_t crcBlock;      // Block in CRC engine (-1 if idle)
+    volatile int16_t crcWaiting;    // Block waiting for engine (-1 if none)
+
+    volatile int16_t inFlight;      // Blocks currently owned by USB
+    volatile uint32_t sentCount;
+    volatile uint32_t droppedCount;
+    volatile ERROR_ID currentError;
+
+    void resetFields();
+
+    void checksumBlock(int16_t blockIndex);
+
+    bool sendBlock(int16_t blockIndex, uint32_t checksum);
+
+    void dropBlock(int16_t blockIndex);
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DMA STATS DUMP
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// One per allocated channel, payload of a stats frame is an array of these
+struct DMAStatsRecord {
+  uint32_t channelIndex;
+  DMAChannelStats stats;
+};
+
+// Snapshots all allocated channels & sends them as one frame on PIPE_STATS_STREAM_ID.
+// Returns false while the previous dump is still going out or if the COM queue is full.
+bool sendDMAStats();
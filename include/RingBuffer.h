@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> RING BUFFER (SPSC)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Own header (pulled in by GlobalTools.h) -> no hardware includes, builds in the native env too
+
+#pragma once
+#include <inttypes.h>
+#include <string.h>
+#include <GlobalDefs.h>
+
+// Single producer (ISR) / single consumer (main loop) ring -> neither side masks interrupts.
+// Indices are free-running & only ever written by their owner, the other side reads them 
+// with acquire semantics so the data written before a release is always visible.
+template<typename T, uint32_t N> class RingBuffer {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+  public:
+    RingBuffer() : head(0), tail(0), overruns(0) {}
+
+    //// PRODUCER ////
+    uint32_t write(const T *source, uint32_t count) {
+      uint32_t h = head;
+      uint32_t t = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+
+      // Drop what does not fit -> producer must never block
+      uint32_t freeCount = N - (h - t);
+      if (count > freeCount) {
+        overruns += count - freeCount;
+        count = freeCount;
+      }
+      // Copy in up to two segments (wrap)
+      uint32_t first = MIN(count, N - (h & (N - 1)));
+      memcpy(data + (h & (N - 1)), source, first * sizeof(T));
+      memcpy(data, source + first, (count - first) * sizeof(T));
+
+      __atomic_store_n(&head, h + count, __ATOMIC_RELEASE);
+      return count;
+    }
+
+    //// CONSUMER ////
+    uint32_t peekContiguous(T *&span) {
+      uint32_t t = tail;
+      uint32_t h = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+      span = data + (t & (N - 1));
+      return MIN(h - t, N - (t & (N - 1)));
+    }
+
+    void commit(uint32_t count) {
+      uint32_t t = tail;
+      uint32_t h = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+      if (count > h - t) count = h - t;
+      __atomic_store_n(&tail, t + count, __ATOMIC_RELEASE);
+    }
+
+    uint32_t available() {
+      return __atomic_load_n(&head, __ATOMIC_ACQUIRE) - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+    }
+
+    uint32_t space() { return N - available(); }
+
+    uint32_t getOverruns() { return overruns; }
+
+    constexpr uint32_t capacity() { return N; }
+
+    // Only valid while the producer is stopped
+    void clear() {
+      head = 0;
+      tail = 0;
+      overruns = 0;
+    }
+
+  private:
+    T data[N];
+    uint32_t head;              // Written by producer only
+    uint32_t tail;              // Written by consumer only
+    volatile uint32_t overruns; // Elements dropped by producer
+};
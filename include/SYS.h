@@ -2,6 +2,7 @@
 #pragma once
 #include <Arduino.h>
 #include <GlobalTools.h>
+#include <DMA.h>
 
 class System_;
 struct CLK_CONFIG;
@@ -45,16 +46,73 @@ class System_ {
     }mem{this};
 
 
-    // Event Utility
+    // Event Utility -> routes event generators to users through EVSYS (no CPU in between)
     struct EVNTUtil {
 
+      int16_t connect(uint8_t generatorID, uint8_t userID, EVENT_PATH path = EVENT_PATH_ASYNC);
+
+      bool addUser(int16_t eventChannel, uint8_t userID);
+
+      bool removeUser(uint8_t userID);
+
+      bool disconnect(int16_t eventChannel);
+
+      bool isConnected(int16_t eventChannel);
+
+      int16_t linkChannels(TransferChannel &source, TransferChannel &target,
+        DMA_EVENT_ACTION action = EVENT_ACTION_TRIGGER);
+
+      int16_t linkChannel(TransferChannel &source, uint8_t userID);
+
+      bool unlinkChannel(TransferChannel &source, int16_t eventChannel);
+
       private:
         friend System_;
         const System_ *super;
         explicit EVNTUtil(System_ *sys) : super(sys){}
+
+        static bool channelUsed[EVNT_CHANNEL_COUNT];
+        static bool begun;
+
+        void init();
     }evnt{this};
 
 
+    // Timer Utility -> TC pacing timers, each overflow is a DMA trigger & an event (EVSYS)
+    struct TIMUtil {
+
+      int16_t allocTimer();
+
+      void freeTimer(int16_t timer);
+
+      float setRate(int16_t timer, float hz);
+
+      float getRate(int16_t timer);
+
+      bool start(int16_t timer);
+
+      bool stop(int16_t timer);
+
+      bool isRunning(int16_t timer);
+
+      DMA_TRIGGER getTrigger(int16_t timer);
+
+      uint8_t getEventGenerator(int16_t timer);
+
+      private:
+        friend System_;
+        const System_ *super;
+        explicit TIMUtil(System_ *sys) : super(sys){}
+
+        static bool timerUsed[TIM_TIMER_COUNT];
+        static float timerRate[TIM_TIMER_COUNT];
+
+        bool isAllocated(int16_t timer);
+
+        void init(int16_t timer);
+    }tim{this};
+
+
     // Error Utility
     struct ERRUtil {
 
@@ -95,6 +153,8 @@ class System_ {
     }core{this};
 
 
+    static System_ instance;  // Backs System
+
   private:
     System_() {}
 
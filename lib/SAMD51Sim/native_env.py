@@ -0,0 +1,5 @@
+# Native env -> descriptors & registers hold 32 bit addresses, so the host build must be 32 bit
+# (compiler & linker both need the flag).
+Import("env")
+
+env.Append(CCFLAGS=["-m32"], LINKFLAGS=["-m32"])
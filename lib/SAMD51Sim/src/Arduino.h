@@ -0,0 +1,25 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> ARDUINO (NATIVE SIM SHIM)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Stands in for the core's Arduino.h in the native env only -> just what the DMA module & the
+// COM send queue need. Time is sim time, see SimCore.h.
+
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <SimCore.h>
+#include <SimDMAC.h>
+#include <SimUSB.h>
+
+uint32_t micros();
+
+uint32_t millis();
+
+void delay(uint32_t ms);
+
+void delayMicroseconds(uint32_t us);
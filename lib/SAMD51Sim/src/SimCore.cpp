@@ -0,0 +1,155 @@
+
+#include <Arduino.h>
+#include <chrono>
+
+SimDWT simDWT;
+SimCoreDebug simCoreDebug;
+SimMclk simMclk;
+
+static uint64_t now = 0;
+static uint32_t primask = 0;
+static bool inHandler = false;
+static bool irqEnabled[SIM_IRQ_COUNT] = { false };
+static bool irqLevel[SIM_IRQ_COUNT] = { false };
+static bool irqSoftPending[SIM_IRQ_COUNT] = { false };
+static SimIRQStats irqStats[SIM_IRQ_COUNT];
+
+static void (*vectorTable[SIM_IRQ_COUNT])(void) = { nullptr };
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> CLOCK
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint64_t simCycles() { return now; }
+
+void simAdvance(uint32_t cycles) {
+  now += cycles;
+  if (simDWT.CTRL & DWT_CTRL_CYCCNTENA_Msk) simDWT.CYCCNT = (uint32_t)now;
+  simDMACRun(now);
+}
+
+uint32_t micros() {
+  simAdvance(SIM_POLL_CYCLES);
+  return (uint32_t)(now / SIM_CYCLES_PER_MICRO);
+}
+
+uint32_t millis() {
+  simAdvance(SIM_POLL_CYCLES);
+  return (uint32_t)(now / (SIM_CYCLES_PER_MICRO * 1000));
+}
+
+void delayMicroseconds(uint32_t us) { simAdvance(us * SIM_CYCLES_PER_MICRO); }
+
+void delay(uint32_t ms) {
+  while (ms-- > 0) simAdvance(SIM_CYCLES_PER_MICRO * 1000);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> NVIC & PRIMASK
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Note -> all DMAC lines share one priority on this project -> no nesting to model
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { (void)irq; (void)priority; }
+
+void NVIC_EnableIRQ(IRQn_Type irq) {
+  if (irq >= SIM_IRQ_COUNT) return;
+  irqEnabled[irq] = true;
+  simDeliverIRQ();
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq) {
+  if (irq < SIM_IRQ_COUNT) irqEnabled[irq] = false;
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type irq) {
+  if (irq >= SIM_IRQ_COUNT) return;
+  irqSoftPending[irq] = true;
+  simDeliverIRQ();
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irq) {
+  if (irq < SIM_IRQ_COUNT) irqSoftPending[irq] = false;
+}
+
+uint32_t __get_PRIMASK(void) { return primask; }
+
+void __disable_irq(void) { primask = 1; }
+
+void __enable_irq(void) {
+  primask = 0;
+  simDeliverIRQ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DELIVERY
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void simSetIRQLevel(IRQn_Type irq, bool asserted) {
+  if (irq >= SIM_IRQ_COUNT) return;
+  irqLevel[irq] = asserted;
+  if (asserted) simDeliverIRQ();
+}
+
+// Lowest number first (NVIC order for equal priority). Handler runs while its line is high ->
+// one that never clears its flags is cut off & counted as a storm.
+void simDeliverIRQ() {
+  if (primask || inHandler) return;
+
+  for (int16_t irq = 0; irq < SIM_IRQ_COUNT; irq++) {
+    void (*handler)(void) = vectorTable[irq];
+    int16_t runs = 0;
+
+    while (irqEnabled[irq] && (irqLevel[irq] || irqSoftPending[irq]) && !primask) {
+      if (runs++ >= SIM_IRQ_MAX_REENTRY) {
+        irqStats[irq].storms++;
+        break;
+      }
+      irqSoftPending[irq] = false;
+      if (handler == nullptr) break;
+
+      inHandler = true;
+      now += SIM_IRQ_ENTRY_CYCLES;
+      if (simDWT.CTRL & DWT_CTRL_CYCCNTENA_Msk) simDWT.CYCCNT = (uint32_t)now;
+      auto start = std::chrono::steady_clock::now();
+      handler();
+      uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+      inHandler = false;
+
+      irqStats[irq].calls++;
+      irqStats[irq].hostNanos += nanos;
+      if (nanos > irqStats[irq].hostNanosMax) irqStats[irq].hostNanosMax = nanos;
+    }
+  }
+}
+
+void simSetVector(IRQn_Type irq, void (*handler)(void)) {
+  if (irq < SIM_IRQ_COUNT) vectorTable[irq] = handler;
+}
+
+bool simGetIRQStats(IRQn_Type irq, SimIRQStats &snapshot) {
+  if (irq >= SIM_IRQ_COUNT) return false;
+  snapshot = irqStats[irq];
+  return true;
+}
+
+void simClearIRQStats() { memset(irqStats, 0, sizeof(irqStats)); }
+
+void simResetCore() {
+  now = 0;
+  primask = 0;
+  inHandler = false;
+  memset(irqEnabled, 0, sizeof(irqEnabled));
+  memset(irqLevel, 0, sizeof(irqLevel));
+  memset(irqSoftPending, 0, sizeof(irqSoftPending));
+  memset(vectorTable, 0, sizeof(vectorTable));
+  vectorTable[DMAC_0_IRQn] = DMAC_0_Handler;
+  vectorTable[DMAC_1_IRQn] = DMAC_1_Handler;
+  vectorTable[DMAC_2_IRQn] = DMAC_2_Handler;
+  vectorTable[DMAC_3_IRQn] = DMAC_3_Handler;
+  vectorTable[DMAC_4_IRQn] = DMAC_4_Handler;
+  memset(&simDWT, 0, sizeof(simDWT));
+  memset(&simCoreDebug, 0, sizeof(simCoreDebug));
+  memset(&simMclk, 0, sizeof(simMclk));
+  simClearIRQStats();
+}
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> SIM CORE (CLOCK, NVIC, PRIMASK, DWT)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <stdint.h>
+
+#ifndef F_CPU
+#define F_CPU 120000000ul
+#endif
+
+#define SIM_CYCLES_PER_MICRO (F_CPU / 1000000ul)
+#define SIM_POLL_CYCLES 24          // Cost of one micros()/millis() call -> lets spin loops progress
+#define SIM_IRQ_ENTRY_CYCLES 12     // Cortex-M4 exception entry (stacking)
+#define SIM_IRQ_MAX_REENTRY 64      // Line still asserted after this many handler runs -> storm
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> CMSIS CORE SUBSET
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define __IO
+#define __I
+#define __O
+#define _U_(x) x##u
+#define _UL_(x) x##ul
+#define __NVIC_PRIO_BITS 3
+
+typedef enum IRQn {
+  DMAC_0_IRQn = 31,
+  DMAC_1_IRQn = 32,
+  DMAC_2_IRQn = 33,
+  DMAC_3_IRQn = 34,
+  DMAC_4_IRQn = 35,
+  USB_3_IRQn = 83,      // TRCPT1 (IN bank done) -> see SimUSB.h
+  SIM_IRQ_COUNT = 84
+} IRQn_Type;
+
+extern "C" {
+  // Weak like the startup file defaults -> unused vectors stay null
+  void DMAC_0_Handler(void) __attribute__((weak));
+  void DMAC_1_Handler(void) __attribute__((weak));
+  void DMAC_2_Handler(void) __attribute__((weak));
+  void DMAC_3_Handler(void) __attribute__((weak));
+  void DMAC_4_Handler(void) __attribute__((weak));
+}
+
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+
+uint32_t __get_PRIMASK(void);
+void __disable_irq(void);
+void __enable_irq(void);   // Delivers whatever became pending while masked
+inline void __DSB(void) { __sync_synchronize(); }
+inline void __DMB(void) { __sync_synchronize(); }
+inline void __ISB(void) { __sync_synchronize(); }
+
+#define DWT_CTRL_CYCCNTENA_Msk (1ul << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1ul << 24)
+
+struct SimDWT {
+  uint32_t CTRL;
+  uint32_t CYCCNT;    // Mirrors sim clock while CYCCNTENA is set
+};
+
+struct SimCoreDebug {
+  uint32_t DEMCR;
+};
+
+struct SimMclk {
+  union {
+    struct {
+      uint32_t :9;
+      uint32_t DMAC_:1;
+      uint32_t :22;
+    } bit;
+    uint32_t reg;
+  } AHBMASK;
+};
+
+extern SimDWT simDWT;
+extern SimCoreDebug simCoreDebug;
+extern SimMclk simMclk;
+
+#define DWT (&simDWT)
+#define CoreDebug (&simCoreDebug)
+#define MCLK (&simMclk)
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> SIM CLOCK & INTERRUPTS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Per line -> how often the handler ran & host time spent in it
+struct SimIRQStats {
+  uint32_t calls;
+  uint64_t hostNanos;
+  uint64_t hostNanosMax;
+  uint32_t storms;      // Line stayed asserted past SIM_IRQ_MAX_REENTRY
+};
+
+uint64_t simCycles();
+
+// Advances the clock & lets the DMAC catch up (handlers run from here)
+void simAdvance(uint32_t cycles);
+
+// Line level from a peripheral model -> handler runs once unmasked while level is high
+void simSetIRQLevel(IRQn_Type irq, bool asserted);
+
+// Runs handlers of asserted (or software pended) lines unless masked
+void simDeliverIRQ();
+
+// Handler for a line w/o a fixed vector (e.g. USB_SetHandler())
+void simSetVector(IRQn_Type irq, void (*handler)(void));
+
+bool simGetIRQStats(IRQn_Type irq, SimIRQStats &snapshot);
+
+void simClearIRQStats();
+
+// Clock, NVIC & PRIMASK back to reset state (does not touch peripherals)
+void simResetCore();
@@ -0,0 +1,466 @@
+
+#include <Arduino.h>
+
+// Model side of a channel -> what the real DMAC keeps internally
+struct SimChannelState {
+  uint8_t inten;
+  bool pending;             // Trigger waiting
+  bool granted;             // Trigger taken -> burst, block or transaction in progress
+  bool active;              // Descriptor fetched, block not finished
+  bool suspended;
+  bool fetchError;
+  bool injectError;
+  bool swappedOut;          // Lost the bus mid block -> descriptor written back, re-fetched
+  uint32_t nextDescriptor;  // Fetched when the next block starts
+  uint32_t blockBeats;      // BTCNT as fetched (end address math)
+  uint32_t beatIndex;       // Beats done in the active block
+  uint32_t unitBeats;       // Beats left of a burst trigger
+};
+
+Dmac simDmac;
+
+static SimChannelState state[DMAC_CH_NUM];
+static SimDMACStats stats[DMAC_CH_NUM];
+static int16_t lastServed[DMAC_LVL_NUM] = { -1, -1, -1, -1 };
+static int16_t busOwner = -1;     // Channel whose descriptor the DMAC holds
+static uint64_t dmacClock = 0;
+static bool running = false;
+
+//// Helpers ////
+static int16_t channelOf(void *reg) {
+  return (int16_t)(((uint8_t*)reg - (uint8_t*)simDmac.Channel) / sizeof(DmacChannel));
+}
+
+static DmacDescriptor *descriptorAt(uint32_t address) {
+  return (DmacDescriptor*)(uintptr_t)address;
+}
+
+static DmacDescriptor *writeback(int16_t ch) {
+  uint32_t base = simDmac.WRBADDR.reg;
+  return base == 0 ? nullptr : descriptorAt(base + ch * sizeof(DmacDescriptor));
+}
+
+static uint32_t primary(int16_t ch) {
+  uint32_t base = simDmac.BASEADDR.reg;
+  return base == 0 ? 0 : base + ch * sizeof(DmacDescriptor);
+}
+
+static bool enabled(int16_t ch) { return simDmac.Channel[ch].CHCTRLA.bit.ENABLE; }
+
+static bool runnable(int16_t ch) {
+  const SimChannelState &s = state[ch];
+  return enabled(ch) && !s.suspended && (s.granted || s.pending);
+}
+
+static void disableChannel(int16_t ch) {
+  SimChannelState &s = state[ch];
+  simDmac.Channel[ch].CHCTRLA.reg.store(simDmac.Channel[ch].CHCTRLA.reg.raw() & ~DMAC_CHCTRLA_ENABLE);
+  s.pending = false;
+  s.granted = false;
+  s.active = false;
+  s.suspended = false;
+  s.nextDescriptor = primary(ch);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> STATUS & INTERRUPT LINES
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Recomputes every read only register & drives the 5 DMAC lines (handlers may run from here)
+static void syncStatus() {
+  uint32_t intStatus = 0, pendCh = 0, busyCh = 0, swTrig = 0;
+  int16_t intPendID = -1;
+
+  for (int16_t ch = 0; ch < DMAC_CH_NUM; ch++) {
+    SimChannelState &s = state[ch];
+    DmacChannel &reg = simDmac.Channel[ch];
+    bool busy = (s.granted || s.active) && !s.suspended && enabled(ch);
+
+    reg.CHSTATUS.reg.store((s.pending ? DMAC_CHSTATUS_PEND : 0) | (busy ? DMAC_CHSTATUS_BUSY : 0)
+      | (s.fetchError ? DMAC_CHSTATUS_FERR : 0));
+    reg.CHINTENSET.reg.store(s.inten);
+    reg.CHINTENCLR.reg.store(s.inten);
+
+    uint8_t flags = reg.CHINTFLAG.reg.raw();
+    if (flags & s.inten) intStatus |= (1ul << ch);
+    if (flags && intPendID < 0) intPendID = ch;
+    if (s.pending) pendCh |= (1ul << ch);
+    if (busy) busyCh |= (1ul << ch);
+    if (s.pending && reg.CHCTRLA.bit.TRIGSRC == 0) swTrig |= (1ul << ch);
+  }
+  simDmac.INTSTATUS.reg.store(intStatus);
+  simDmac.PENDCH.reg.store(pendCh);
+  simDmac.BUSYCH.reg.store(busyCh);
+  simDmac.SWTRIGCTRL.reg.store(swTrig);
+
+  // INTPEND -> lowest channel w a flag
+  uint16_t intPend = 0;
+  if (intPendID >= 0) {
+    uint8_t flags = simDmac.Channel[intPendID].CHINTFLAG.reg.raw();
+    uint8_t status = simDmac.Channel[intPendID].CHSTATUS.reg.raw();
+    intPend = intPendID | ((flags & DMAC_CHINTFLAG_TERR) ? (1u << 9) : 0)
+      | ((flags & DMAC_CHINTFLAG_TCMPL) ? (1u << 10) : 0)
+      | ((flags & DMAC_CHINTFLAG_SUSP) ? (1u << 11) : 0)
+      | ((status & DMAC_CHSTATUS_FERR) ? (1u << 13) : 0)
+      | ((status & DMAC_CHSTATUS_BUSY) ? (1u << 14) : 0)
+      | ((status & DMAC_CHSTATUS_PEND) ? (1u << 15) : 0);
+  }
+  simDmac.INTPEND.reg.store(intPend);
+
+  // Channels 0 - 3 own a line each, the rest share DMAC_4
+  for (int16_t ch = 0; ch < 4; ch++) {
+    simSetIRQLevel((IRQn_Type)(DMAC_0_IRQn + ch), intStatus & (1ul << ch));
+  }
+  simSetIRQLevel(DMAC_4_IRQn, intStatus & ~0xFul);
+}
+
+static void raiseFlags(int16_t ch, uint8_t flags) {
+  DMAC_CHINTFLAG_Type &reg = simDmac.Channel[ch].CHINTFLAG;
+  reg.reg.store(reg.reg.raw() | flags);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> REGISTER HOOKS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void simHookCTRL(void *reg, uint32_t previous, uint32_t written) {
+  (void)reg;
+  (void)previous;
+  if (written & DMAC_CTRL_SWRST) {
+    simDMACReset();
+    return;
+  }
+  syncStatus();
+}
+
+// Write one to clear
+void simHookCRCSTATUS(void *reg, uint32_t previous, uint32_t written) {
+  simDmac.CRCSTATUS.reg.store(previous & ~written);
+  (void)reg;
+}
+
+void simHookSWTRIGCTRL(void *reg, uint32_t previous, uint32_t written) {
+  (void)reg;
+  uint32_t set = written & ~previous;
+  for (int16_t ch = 0; ch < DMAC_CH_NUM; ch++) {
+    if ((set & (1ul << ch)) && enabled(ch)) {
+      state[ch].pending = true;
+      stats[ch].triggers++;
+    }
+  }
+  syncStatus();
+}
+
+void simHookCHCTRLA(void *reg, uint32_t previous, uint32_t written) {
+  int16_t ch = channelOf(reg);
+  DmacChannel &channel = simDmac.Channel[ch];
+
+  // Reset only takes on a disabled channel -> bit reads back 0 once done
+  if (written & DMAC_CHCTRLA_SWRST) {
+    if (!(previous & DMAC_CHCTRLA_ENABLE)) {
+      channel.CHCTRLA.reg.store(0);
+      channel.CHCTRLB.reg.store(0);
+      channel.CHPRILVL.reg.store(0);
+      channel.CHEVCTRL.reg.store(0);
+      channel.CHINTFLAG.reg.store(0);
+      memset(&state[ch], 0, sizeof(SimChannelState));
+      state[ch].nextDescriptor = primary(ch);
+    } else {
+      channel.CHCTRLA.reg.store(written & ~DMAC_CHCTRLA_SWRST);
+    }
+  } else if ((written & DMAC_CHCTRLA_ENABLE) && !(previous & DMAC_CHCTRLA_ENABLE)) {
+    SimChannelState &s = state[ch];
+    s.pending = false;
+    s.granted = false;
+    s.active = false;
+    s.suspended = false;
+    s.fetchError = false;
+    s.nextDescriptor = primary(ch);
+  } else if (!(written & DMAC_CHCTRLA_ENABLE) && (previous & DMAC_CHCTRLA_ENABLE)) {
+    disableChannel(ch);
+  }
+  syncStatus();
+}
+
+// Commands act between bursts -> model is always between bursts when software runs
+void simHookCHCTRLB(void *reg, uint32_t previous, uint32_t written) {
+  (void)previous;
+  int16_t ch = channelOf(reg);
+  SimChannelState &s = state[ch];
+
+  switch (written & 0x3) {
+    case DMAC_CHCTRLB_CMD_SUSPEND_Val:
+      if (enabled(ch)) {
+        s.suspended = true;
+        raiseFlags(ch, DMAC_CHINTFLAG_SUSP);
+      }
+      break;
+    case DMAC_CHCTRLB_CMD_RESUME_Val:
+      s.suspended = false;
+      s.fetchError = false;
+      break;
+    default:
+      break;
+  }
+  simDmac.Channel[ch].CHCTRLB.reg.store(written & ~0x3);
+  syncStatus();
+}
+
+void simHookCHINTENCLR(void *reg, uint32_t previous, uint32_t written) {
+  (void)previous;
+  state[channelOf(reg)].inten &= ~written;
+  syncStatus();
+}
+
+void simHookCHINTENSET(void *reg, uint32_t previous, uint32_t written) {
+  (void)previous;
+  state[channelOf(reg)].inten |= written & DMAC_CHINTENSET_MASK;
+  syncStatus();
+}
+
+// Write one to clear
+void simHookCHINTFLAG(void *reg, uint32_t previous, uint32_t written) {
+  simDmac.Channel[channelOf(reg)].CHINTFLAG.reg.store(previous & ~written);
+  syncStatus();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> TRANSFER ENGINE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void feedCRC(const uint8_t *data, uint32_t length) {
+  uint32_t crc = simDmac.CRCCHKSUM.reg.raw();
+  bool crc32 = simDmac.CRCCTRL.bit.CRCPOLY == DMAC_CRCCTRL_CRCPOLY_CRC32_Val;
+
+  for (uint32_t i = 0; i < length; i++) {
+    if (crc32) {
+      crc ^= data[i];
+      for (int16_t b = 0; b < 8; b++) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320ul : (crc >> 1);
+    } else {
+      crc ^= (uint32_t)data[i] << 8;
+      for (int16_t b = 0; b < 8; b++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+      crc &= 0xFFFF;
+    }
+  }
+  simDmac.CRCCHKSUM.reg.store(crc);
+  simDmac.CRCSTATUS.reg.store(simDmac.CRCSTATUS.reg.raw() | DMAC_CRCSTATUS_CRCBUSY);
+}
+
+// Highest enabled level first, round robin inside a level if enabled else lowest channel
+static int16_t arbitrate() {
+  if (!simDmac.CTRL.bit.DMAENABLE) return -1;
+
+  for (int16_t lvl = DMAC_LVL_NUM - 1; lvl >= 0; lvl--) {
+    if (!(simDmac.CTRL.reg.raw() & (1u << (DMAC_CTRL_LVLEN_Pos + lvl)))) continue;
+    bool roundRobin = simDmac.PRICTRL0.reg.raw() & (1ul << (DMAC_PRICTRL0_RRLVLEN0_Pos + 8 * lvl));
+    int16_t start = roundRobin ? lastServed[lvl] + 1 : 0;
+
+    for (int16_t i = 0; i < DMAC_CH_NUM; i++) {
+      int16_t ch = (start + i) % DMAC_CH_NUM;
+      if (simDmac.Channel[ch].CHPRILVL.bit.PRILVL == lvl && runnable(ch)) {
+        lastServed[lvl] = ch;
+        return ch;
+      }
+    }
+  }
+  return -1;
+}
+
+// One bus grant -> fetch if needed & one burst. Descriptor is written back when the block ends
+// or another channel takes the bus mid block. Returns cycles spent.
+static uint32_t serve(int16_t ch) {
+  SimChannelState &s = state[ch];
+  DmacChannel &reg = simDmac.Channel[ch];
+  uint32_t cycles = SIM_DMAC_GRANT_CYCLES;
+  uint32_t burst = reg.CHCTRLA.bit.BURSTLEN + 1;
+
+  // Channel switch -> previous owner saves its state, this one loads its own
+  if (busOwner != ch) {
+    if (busOwner >= 0 && state[busOwner].active) {
+      cycles += SIM_DMAC_WRITEBACK_CYCLES;
+      state[busOwner].swappedOut = true;
+    }
+    if (s.active && s.swappedOut) cycles += SIM_DMAC_FETCH_CYCLES;
+    s.swappedOut = false;
+    busOwner = ch;
+  }
+  if (!s.granted) {
+    s.granted = true;
+    s.pending = false;
+    s.unitBeats = burst;
+  }
+  // Fetch -> invalid descriptor suspends the channel w FERR
+  DmacDescriptor *wb = writeback(ch);
+  if (!s.active) {
+    cycles += SIM_DMAC_FETCH_CYCLES;
+    stats[ch].fetches++;
+    DmacDescriptor *desc = descriptorAt(s.nextDescriptor);
+    if (desc == nullptr || wb == nullptr || !desc->BTCTRL.bit.VALID) {
+      stats[ch].fetchErrors++;
+      s.fetchError = true;
+      s.suspended = true;
+      s.granted = false;
+      raiseFlags(ch, DMAC_CHINTFLAG_SUSP);
+      return cycles;
+    }
+    memcpy(wb, desc, sizeof(DmacDescriptor));
+    s.blockBeats = desc->BTCNT.bit.BTCNT;
+    s.beatIndex = 0;
+    s.active = true;
+  }
+  // Beat addresses from end addresses -> SRCADDR = start + BTCNT * beat * step
+  uint32_t beatBytes = 1u << wb->BTCTRL.bit.BEATSIZE;
+  uint32_t step = 1u << wb->BTCTRL.bit.STEPSIZE;
+  bool stepSrc = wb->BTCTRL.bit.STEPSEL == DMAC_BTCTRL_STEPSEL_SRC_Val;
+  uint32_t srcStride = wb->BTCTRL.bit.SRCINC ? beatBytes * (stepSrc ? step : 1) : 0;
+  uint32_t dstStride = wb->BTCTRL.bit.DSTINC ? beatBytes * (stepSrc ? 1 : step) : 0;
+  uint32_t srcStart = wb->SRCADDR.reg - s.blockBeats * srcStride;
+  uint32_t dstStart = wb->DSTADDR.reg - s.blockBeats * dstStride;
+  bool crc = simDmac.CRCCTRL.bit.CRCSRC == 0x20 + ch;
+
+  uint32_t beats = s.blockBeats - s.beatIndex;
+  if (beats > burst) beats = burst;
+  if (reg.CHCTRLA.bit.TRIGACT == DMAC_CHCTRLA_TRIGACT_BURST_Val && beats > s.unitBeats) {
+    beats = s.unitBeats;
+  }
+  for (uint32_t i = 0; i < beats; i++, s.beatIndex++) {
+    uint32_t src = srcStart + s.beatIndex * srcStride;
+    uint32_t dst = dstStart + s.beatIndex * dstStride;
+
+    // Bus error -> channel disabled w TERR, rest of the block is lost
+    if (s.injectError || src == 0 || dst == 0) {
+      s.injectError = false;
+      stats[ch].busyCycles += cycles;
+      disableChannel(ch);
+      raiseFlags(ch, DMAC_CHINTFLAG_TERR);
+      return cycles;
+    }
+    memcpy((void*)(uintptr_t)dst, (const void*)(uintptr_t)src, beatBytes);
+    if (crc) feedCRC((const uint8_t*)(uintptr_t)src, beatBytes);
+    cycles += SIM_DMAC_BEAT_CYCLES;
+  }
+  stats[ch].beats += beats;
+  wb->BTCNT.reg = (uint16_t)(s.blockBeats - s.beatIndex);
+
+  if (reg.CHCTRLA.bit.TRIGACT == DMAC_CHCTRLA_TRIGACT_BURST_Val) {
+    s.unitBeats -= beats;
+    if (s.unitBeats == 0) s.granted = false;
+  }
+  // Block done -> next descriptor comes from writeback (software may have re-linked it)
+  if (s.beatIndex >= s.blockBeats) {
+    cycles += SIM_DMAC_WRITEBACK_CYCLES;
+    stats[ch].blocks++;
+    s.active = false;
+    s.nextDescriptor = wb->DESCADDR.reg;
+    uint8_t blockAction = wb->BTCTRL.bit.BLOCKACT;
+    uint8_t flags = 0;
+    if (blockAction == DMAC_BTCTRL_BLOCKACT_INT_Val || blockAction == DMAC_BTCTRL_BLOCKACT_BOTH_Val) {
+      flags |= DMAC_CHINTFLAG_TCMPL;
+    }
+    if (blockAction == DMAC_BTCTRL_BLOCKACT_SUSPEND_Val
+    || blockAction == DMAC_BTCTRL_BLOCKACT_BOTH_Val) {
+      flags |= DMAC_CHINTFLAG_SUSP;
+      s.suspended = true;
+    }
+    // Last block -> transaction over, channel disables itself
+    if (s.nextDescriptor == 0) {
+      disableChannel(ch);
+    } else if (reg.CHCTRLA.bit.TRIGACT == DMAC_CHCTRLA_TRIGACT_BLOCK_Val) {
+      s.granted = false;
+    }
+    raiseFlags(ch, flags);
+  }
+  stats[ch].busyCycles += cycles;
+  return cycles;
+}
+
+void simDMACRun(uint64_t now) {
+  if (running) return;  // Handler called micros() -> outer loop keeps going
+  running = true;
+
+  while (dmacClock < now) {
+    int16_t ch = arbitrate();
+    if (ch < 0) {
+      dmacClock = now;
+      break;
+    }
+    dmacClock += serve(ch);
+    syncStatus();
+  }
+  running = false;
+}
+
+bool simDMACIdle() {
+  for (int16_t ch = 0; ch < DMAC_CH_NUM; ch++) {
+    if (runnable(ch)) return false;
+  }
+  return true;
+}
+
+bool simDMACRunUntilIdle(uint32_t maxCycles) {
+  uint64_t end = simCycles() + maxCycles;
+  while (!simDMACIdle()) {
+    if (simCycles() >= end) return false;
+    simAdvance(SIM_DMAC_FETCH_CYCLES + SIM_DMAC_BEAT_CYCLES * 16);
+  }
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> BENCH SIDE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void simDMACTrigger(uint8_t triggerSource) {
+  if (triggerSource == 0) return;   // Software -> SWTRIGCTRL
+  for (int16_t ch = 0; ch < DMAC_CH_NUM; ch++) {
+    if (enabled(ch) && simDmac.Channel[ch].CHCTRLA.bit.TRIGSRC == triggerSource) {
+      state[ch].pending = true;
+      stats[ch].triggers++;
+    }
+  }
+  syncStatus();
+}
+
+// EVACT -> 1 TRIG, 2 CTRIG, 3 CBLOCK start a transfer, 4 SUSPEND, 5 RESUME (rest ignored)
+void simDMACEvent(int16_t channelIndex) {
+  if (channelIndex < 0 || channelIndex >= DMAC_CH_NUM) return;
+  DmacChannel &reg = simDmac.Channel[channelIndex];
+  if (!reg.CHEVCTRL.bit.EVIE || !enabled(channelIndex)) return;
+
+  switch (reg.CHEVCTRL.bit.EVACT) {
+    case 1: case 2: case 3:
+      state[channelIndex].pending = true;
+      stats[channelIndex].triggers++;
+      break;
+    case 4:
+      reg.CHCTRLB.bit.CMD = DMAC_CHCTRLB_CMD_SUSPEND_Val;
+      break;
+    case 5:
+      reg.CHCTRLB.bit.CMD = DMAC_CHCTRLB_CMD_RESUME_Val;
+      break;
+    default:
+      break;
+  }
+  syncStatus();
+}
+
+void simDMACInjectError(int16_t channelIndex) {
+  if (channelIndex >= 0 && channelIndex < DMAC_CH_NUM) state[channelIndex].injectError = true;
+}
+
+bool simDMACGetStats(int16_t channelIndex, SimDMACStats &snapshot) {
+  if (channelIndex < 0 || channelIndex >= DMAC_CH_NUM) return false;
+  snapshot = stats[channelIndex];
+  return true;
+}
+
+void simDMACClearStats() { memset(stats, 0, sizeof(stats)); }
+
+void simDMACReset() {
+  memset((void*)&simDmac, 0, sizeof(simDmac));
+  memset(state, 0, sizeof(state));
+  for (int16_t i = 0; i < DMAC_LVL_NUM; i++) lastServed[i] = -1;
+  busOwner = -1;
+  dmacClock = simCycles();
+  syncStatus();
+}
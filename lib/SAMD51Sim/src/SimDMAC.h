@@ -0,0 +1,390 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> SIM DMAC (SAMD51 DMA CONTROLLER MODEL)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <stdint.h>
+#include <SimReg.h>
+#include <SimCore.h>
+
+// Cycle costs -> approximate, one AHB access per word/beat
+#define SIM_DMAC_FETCH_CYCLES 5       // Descriptor fetch (4 words + arbitration)
+#define SIM_DMAC_WRITEBACK_CYCLES 4   // Writeback (4 words)
+#define SIM_DMAC_BEAT_CYCLES 2        // Read + write of one beat
+#define SIM_DMAC_GRANT_CYCLES 1       // Arbitration per burst
+
+#define DMAC_CH_NUM 32
+#define DMAC_LVL_NUM 4
+#define SECTION_DMAC_DESCRIPTOR
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> REGISTER MACROS (NAMES & VALUES AS CMSIS)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define DMAC_CTRL_SWRST (1u << 0)
+#define DMAC_CTRL_DMAENABLE (1u << 1)
+#define DMAC_CTRL_LVLEN_Pos 8
+#define DMAC_CTRL_LVLEN(value) (((value) & 0xFu) << DMAC_CTRL_LVLEN_Pos)
+
+#define DMAC_CRCCTRL_CRCBEATSIZE_Pos 0
+#define DMAC_CRCCTRL_CRCBEATSIZE(value) (((value) & 0x3u) << DMAC_CRCCTRL_CRCBEATSIZE_Pos)
+#define DMAC_CRCCTRL_CRCPOLY_Pos 2
+#define DMAC_CRCCTRL_CRCPOLY(value) (((value) & 0x3u) << DMAC_CRCCTRL_CRCPOLY_Pos)
+#define DMAC_CRCCTRL_CRCPOLY_CRC16_Val 0x0u
+#define DMAC_CRCCTRL_CRCPOLY_CRC32_Val 0x1u
+#define DMAC_CRCCTRL_CRCSRC_Pos 8
+#define DMAC_CRCCTRL_CRCSRC(value) (((value) & 0x3Fu) << DMAC_CRCCTRL_CRCSRC_Pos)
+#define DMAC_CRCCTRL_CRCSRC_DISABLE_Val 0x0u
+#define DMAC_CRCCTRL_CRCSRC_IO_Val 0x1u
+
+#define DMAC_CRCSTATUS_CRCBUSY (1u << 0)
+#define DMAC_CRCSTATUS_CRCZERO (1u << 1)
+#define DMAC_CRCSTATUS_CRCERR (1u << 2)
+
+#define DMAC_PRICTRL0_RRLVLEN0_Pos 7
+
+#define DMAC_CHCTRLA_SWRST (1u << 0)
+#define DMAC_CHCTRLA_ENABLE (1u << 1)
+#define DMAC_CHCTRLA_RUNSTDBY (1u << 6)
+#define DMAC_CHCTRLA_TRIGSRC_Pos 8
+#define DMAC_CHCTRLA_TRIGSRC(value) (((value) & 0x7Fu) << DMAC_CHCTRLA_TRIGSRC_Pos)
+#define DMAC_CHCTRLA_TRIGACT_Pos 20
+#define DMAC_CHCTRLA_TRIGACT(value) (((value) & 0x3u) << DMAC_CHCTRLA_TRIGACT_Pos)
+#define DMAC_CHCTRLA_TRIGACT_BLOCK_Val 0x0u
+#define DMAC_CHCTRLA_TRIGACT_BURST_Val 0x2u
+#define DMAC_CHCTRLA_TRIGACT_TRANSACTION_Val 0x3u
+#define DMAC_CHCTRLA_BURSTLEN_Pos 24
+#define DMAC_CHCTRLA_BURSTLEN(value) (((value) & 0xFu) << DMAC_CHCTRLA_BURSTLEN_Pos)
+#define DMAC_CHCTRLA_THRESHOLD_Pos 28
+#define DMAC_CHCTRLA_THRESHOLD(value) (((value) & 0x3u) << DMAC_CHCTRLA_THRESHOLD_Pos)
+#define DMAC_CHCTRLA_MASK 0x3F307F43u
+#define DMAC_CHCTRLA_THRESHOLD_1BEAT_Val 0x0u
+#define DMAC_CHCTRLA_THRESHOLD_2BEATS_Val 0x1u
+#define DMAC_CHCTRLA_THRESHOLD_4BEATS_Val 0x2u
+#define DMAC_CHCTRLA_THRESHOLD_8BEATS_Val 0x3u
+#define DMAC_CHCTRLA_BURSTLEN_SINGLE_Val 0x0u
+#define DMAC_CHCTRLA_BURSTLEN_2BEAT_Val 0x1u
+#define DMAC_CHCTRLA_BURSTLEN_3BEAT_Val 0x2u
+#define DMAC_CHCTRLA_BURSTLEN_4BEAT_Val 0x3u
+#define DMAC_CHCTRLA_BURSTLEN_5BEAT_Val 0x4u
+#define DMAC_CHCTRLA_BURSTLEN_6BEAT_Val 0x5u
+#define DMAC_CHCTRLA_BURSTLEN_7BEAT_Val 0x6u
+#define DMAC_CHCTRLA_BURSTLEN_8BEAT_Val 0x7u
+#define DMAC_CHCTRLA_BURSTLEN_9BEAT_Val 0x8u
+#define DMAC_CHCTRLA_BURSTLEN_10BEAT_Val 0x9u
+#define DMAC_CHCTRLA_BURSTLEN_11BEAT_Val 0xAu
+#define DMAC_CHCTRLA_BURSTLEN_12BEAT_Val 0xBu
+#define DMAC_CHCTRLA_BURSTLEN_13BEAT_Val 0xCu
+#define DMAC_CHCTRLA_BURSTLEN_14BEAT_Val 0xDu
+#define DMAC_CHCTRLA_BURSTLEN_15BEAT_Val 0xEu
+#define DMAC_CHCTRLA_BURSTLEN_16BEAT_Val 0xFu
+
+#define DMAC_CHCTRLB_CMD_NOACT_Val 0x0u
+#define DMAC_CHCTRLB_CMD_SUSPEND_Val 0x1u
+#define DMAC_CHCTRLB_CMD_RESUME_Val 0x2u
+
+#define DMAC_CHINTENCLR_TERR (1u << 0)
+#define DMAC_CHINTENCLR_TCMPL (1u << 1)
+#define DMAC_CHINTENCLR_SUSP (1u << 2)
+#define DMAC_CHINTENCLR_MASK 0x07u
+#define DMAC_CHINTENCLR_RESETVALUE 0x00u
+#define DMAC_CHINTENSET_TERR (1u << 0)
+#define DMAC_CHINTENSET_TCMPL (1u << 1)
+#define DMAC_CHINTENSET_SUSP (1u << 2)
+#define DMAC_CHINTENSET_MASK 0x07u
+#define DMAC_CHINTENSET_RESETVALUE 0x00u
+#define DMAC_CHINTFLAG_TERR (1u << 0)
+#define DMAC_CHINTFLAG_TCMPL (1u << 1)
+#define DMAC_CHINTFLAG_SUSP (1u << 2)
+#define DMAC_CHINTFLAG_MASK 0x07u
+#define DMAC_CHINTFLAG_RESETVALUE 0x00u
+
+#define DMAC_CHSTATUS_PEND (1u << 0)
+#define DMAC_CHSTATUS_BUSY (1u << 1)
+#define DMAC_CHSTATUS_FERR (1u << 2)
+#define DMAC_CHSTATUS_CRCERR (1u << 3)
+
+#define DMAC_BTCTRL_VALID (1u << 0)
+#define DMAC_BTCTRL_EVOSEL_Pos 1
+#define DMAC_BTCTRL_BLOCKACT_Pos 3
+#define DMAC_BTCTRL_BEATSIZE_Pos 8
+#define DMAC_BTCTRL_SRCINC_Pos 10
+#define DMAC_BTCTRL_DSTINC_Pos 11
+#define DMAC_BTCTRL_STEPSEL_Pos 12
+#define DMAC_BTCTRL_STEPSIZE_Pos 13
+#define DMAC_BTCTRL_BLOCKACT_NOACT_Val 0x0u
+#define DMAC_BTCTRL_BLOCKACT_INT_Val 0x1u
+#define DMAC_BTCTRL_BLOCKACT_SUSPEND_Val 0x2u
+#define DMAC_BTCTRL_BLOCKACT_BOTH_Val 0x3u
+#define DMAC_BTCTRL_BEATSIZE_BYTE_Val 0x0u
+#define DMAC_BTCTRL_BEATSIZE_HWORD_Val 0x1u
+#define DMAC_BTCTRL_BEATSIZE_WORD_Val 0x2u
+#define DMAC_BTCTRL_STEPSEL_DST_Val 0x0u
+#define DMAC_BTCTRL_STEPSEL_SRC_Val 0x1u
+#define DMAC_BTCTRL_STEPSIZE_X1_Val 0x0u
+#define DMAC_BTCTRL_STEPSIZE_X2_Val 0x1u
+#define DMAC_BTCTRL_STEPSIZE_X4_Val 0x2u
+#define DMAC_BTCTRL_STEPSIZE_X8_Val 0x3u
+#define DMAC_BTCTRL_STEPSIZE_X16_Val 0x4u
+#define DMAC_BTCTRL_STEPSIZE_X32_Val 0x5u
+#define DMAC_BTCTRL_STEPSIZE_X64_Val 0x6u
+#define DMAC_BTCTRL_STEPSIZE_X128_Val 0x7u
+#define DMAC_SRCADDR_RESETVALUE 0x00000000u
+#define DMAC_DSTADDR_RESETVALUE 0x00000000u
+#define DMAC_DESCADDR_RESETVALUE 0x00000000u
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DESCRIPTOR (PLAIN MEMORY)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+SIM_REG_UNION(DMAC_BTCTRL_Type, uint16_t,
+  uint16_t VALID:1;
+  uint16_t EVOSEL:2;
+  uint16_t BLOCKACT:2;
+  uint16_t :3;
+  uint16_t BEATSIZE:2;
+  uint16_t SRCINC:1;
+  uint16_t DSTINC:1;
+  uint16_t STEPSEL:1;
+  uint16_t STEPSIZE:3;
+);
+
+SIM_REG_UNION(DMAC_BTCNT_Type, uint16_t, uint16_t BTCNT:16;);
+SIM_REG_UNION(DMAC_SRCADDR_Type, uint32_t, uint32_t SRCADDR:32;);
+SIM_REG_UNION(DMAC_DSTADDR_Type, uint32_t, uint32_t DSTADDR:32;);
+SIM_REG_UNION(DMAC_DESCADDR_Type, uint32_t, uint32_t DESCADDR:32;);
+
+typedef struct {
+  DMAC_BTCTRL_Type BTCTRL;
+  DMAC_BTCNT_Type BTCNT;
+  DMAC_SRCADDR_Type SRCADDR;
+  DMAC_DSTADDR_Type DSTADDR;
+  DMAC_DESCADDR_Type DESCADDR;
+} __attribute__((aligned(8))) DmacDescriptor;
+
+static_assert(sizeof(DmacDescriptor) == 16, "Descriptor layout must match hardware");
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> REGISTERS (HOOKED)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void simHookCTRL(void *reg, uint32_t previous, uint32_t written);
+void simHookCRCSTATUS(void *reg, uint32_t previous, uint32_t written);
+void simHookSWTRIGCTRL(void *reg, uint32_t previous, uint32_t written);
+void simHookCHCTRLA(void *reg, uint32_t previous, uint32_t written);
+void simHookCHCTRLB(void *reg, uint32_t previous, uint32_t written);
+void simHookCHINTENCLR(void *reg, uint32_t previous, uint32_t written);
+void simHookCHINTENSET(void *reg, uint32_t previous, uint32_t written);
+void simHookCHINTFLAG(void *reg, uint32_t previous, uint32_t written);
+
+typedef union {
+  union {
+    SimField<uint16_t, 0, 1, simHookCTRL> SWRST;
+    SimField<uint16_t, 1, 1, simHookCTRL> DMAENABLE;
+    SimField<uint16_t, 8, 1, simHookCTRL> LVLEN0;
+    SimField<uint16_t, 9, 1, simHookCTRL> LVLEN1;
+    SimField<uint16_t, 10, 1, simHookCTRL> LVLEN2;
+    SimField<uint16_t, 11, 1, simHookCTRL> LVLEN3;
+  } bit;
+  SimField<uint16_t, 0, 16, simHookCTRL> reg;
+} DMAC_CTRL_Type;
+
+typedef union {
+  union {
+    SimField<uint16_t, 0, 2> CRCBEATSIZE;
+    SimField<uint16_t, 2, 2> CRCPOLY;
+    SimField<uint16_t, 8, 6> CRCSRC;
+    SimField<uint16_t, 14, 2> CRCMODE;
+  } bit;
+  SimField<uint16_t, 0, 16> reg;
+} DMAC_CRCCTRL_Type;
+
+typedef union {
+  union {
+    SimField<uint8_t, 0, 1, simHookCRCSTATUS> CRCBUSY;
+    SimField<uint8_t, 1, 1, simHookCRCSTATUS> CRCZERO;
+    SimField<uint8_t, 2, 1, simHookCRCSTATUS> CRCERR;
+  } bit;
+  SimField<uint8_t, 0, 8, simHookCRCSTATUS> reg;
+} DMAC_CRCSTATUS_Type;
+
+typedef union {
+  SimField<uint32_t, 0, 32, simHookSWTRIGCTRL> reg;
+} DMAC_SWTRIGCTRL_Type;
+
+typedef union {
+  union {
+    SimField<uint32_t, 7, 1> RRLVLEN0;
+    SimField<uint32_t, 15, 1> RRLVLEN1;
+    SimField<uint32_t, 23, 1> RRLVLEN2;
+    SimField<uint32_t, 31, 1> RRLVLEN3;
+  } bit;
+  SimField<uint32_t, 0, 32> reg;
+} DMAC_PRICTRL0_Type;
+
+// Read only -> kept current by the model
+typedef union {
+  union {
+    SimField<uint16_t, 0, 5> ID;
+    SimField<uint16_t, 8, 1> CRCERR;
+    SimField<uint16_t, 9, 1> TERR;
+    SimField<uint16_t, 10, 1> TCMPL;
+    SimField<uint16_t, 11, 1> SUSP;
+    SimField<uint16_t, 13, 1> FERR;
+    SimField<uint16_t, 14, 1> BUSY;
+    SimField<uint16_t, 15, 1> PEND;
+  } bit;
+  SimField<uint16_t, 0, 16> reg;
+} DMAC_INTPEND_Type;
+
+typedef union {
+  SimField<uint32_t, 0, 32> reg;
+} DMAC_WORD_Type;
+
+typedef union {
+  union {
+    SimField<uint32_t, 0, 32> BASEADDR;
+  } bit;
+  SimField<uint32_t, 0, 32> reg;
+} DMAC_BASEADDR_Type;
+
+typedef union {
+  union {
+    SimField<uint32_t, 0, 32> WRBADDR;
+  } bit;
+  SimField<uint32_t, 0, 32> reg;
+} DMAC_WRBADDR_Type;
+
+typedef union {
+  union {
+    SimField<uint32_t, 0, 1, simHookCHCTRLA> SWRST;
+    SimField<uint32_t, 1, 1, simHookCHCTRLA> ENABLE;
+    SimField<uint32_t, 6, 1, simHookCHCTRLA> RUNSTDBY;
+    SimField<uint32_t, 8, 7, simHookCHCTRLA> TRIGSRC;
+    SimField<uint32_t, 20, 2, simHookCHCTRLA> TRIGACT;
+    SimField<uint32_t, 24, 4, simHookCHCTRLA> BURSTLEN;
+    SimField<uint32_t, 28, 2, simHookCHCTRLA> THRESHOLD;
+  } bit;
+  SimField<uint32_t, 0, 32, simHookCHCTRLA> reg;
+} DMAC_CHCTRLA_Type;
+
+typedef union {
+  union {
+    SimField<uint8_t, 0, 2, simHookCHCTRLB> CMD;
+  } bit;
+  SimField<uint8_t, 0, 8, simHookCHCTRLB> reg;
+} DMAC_CHCTRLB_Type;
+
+typedef union {
+  union {
+    SimField<uint8_t, 0, 2> PRILVL;
+  } bit;
+  SimField<uint8_t, 0, 8> reg;
+} DMAC_CHPRILVL_Type;
+
+typedef union {
+  union {
+    SimField<uint8_t, 0, 3> EVACT;
+    SimField<uint8_t, 4, 2> EVOMODE;
+    SimField<uint8_t, 6, 1> EVIE;
+    SimField<uint8_t, 7, 1> EVOE;
+  } bit;
+  SimField<uint8_t, 0, 8> reg;
+} DMAC_CHEVCTRL_Type;
+
+#define SIM_CHINT_TYPE(NAME, HOOK)                  \
+  typedef union {                                   \
+    union {                                         \
+      SimField<uint8_t, 0, 1, HOOK> TERR;           \
+      SimField<uint8_t, 1, 1, HOOK> TCMPL;          \
+      SimField<uint8_t, 2, 1, HOOK> SUSP;           \
+    } bit;                                          \
+    SimField<uint8_t, 0, 8, HOOK> reg;              \
+  } NAME
+
+SIM_CHINT_TYPE(DMAC_CHINTENCLR_Type, simHookCHINTENCLR);
+SIM_CHINT_TYPE(DMAC_CHINTENSET_Type, simHookCHINTENSET);
+SIM_CHINT_TYPE(DMAC_CHINTFLAG_Type, simHookCHINTFLAG);
+
+// Read only -> kept current by the model
+typedef union {
+  union {
+    SimField<uint8_t, 0, 1> PEND;
+    SimField<uint8_t, 1, 1> BUSY;
+    SimField<uint8_t, 2, 1> FERR;
+    SimField<uint8_t, 3, 1> CRCERR;
+  } bit;
+  SimField<uint8_t, 0, 8> reg;
+} DMAC_CHSTATUS_Type;
+
+typedef struct {
+  DMAC_CHCTRLA_Type CHCTRLA;
+  DMAC_CHCTRLB_Type CHCTRLB;
+  DMAC_CHPRILVL_Type CHPRILVL;
+  DMAC_CHEVCTRL_Type CHEVCTRL;
+  uint8_t reserved[5];
+  DMAC_CHINTENCLR_Type CHINTENCLR;
+  DMAC_CHINTENSET_Type CHINTENSET;
+  DMAC_CHINTFLAG_Type CHINTFLAG;
+  DMAC_CHSTATUS_Type CHSTATUS;
+} DmacChannel;
+
+typedef struct {
+  DMAC_CTRL_Type CTRL;
+  DMAC_CRCCTRL_Type CRCCTRL;
+  DMAC_WORD_Type CRCDATAIN;
+  DMAC_WORD_Type CRCCHKSUM;
+  DMAC_CRCSTATUS_Type CRCSTATUS;
+  DMAC_WORD_Type DBGCTRL;
+  DMAC_SWTRIGCTRL_Type SWTRIGCTRL;
+  DMAC_PRICTRL0_Type PRICTRL0;
+  DMAC_INTPEND_Type INTPEND;
+  DMAC_WORD_Type INTSTATUS;
+  DMAC_WORD_Type BUSYCH;
+  DMAC_WORD_Type PENDCH;
+  DMAC_WORD_Type ACTIVE;
+  DMAC_BASEADDR_Type BASEADDR;
+  DMAC_WRBADDR_Type WRBADDR;
+  DmacChannel Channel[DMAC_CH_NUM];
+} Dmac;
+
+extern Dmac simDmac;
+#define DMAC (&simDmac)
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> MODEL CONTROL (BENCH SIDE)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Per channel activity seen by the model
+struct SimDMACStats {
+  uint32_t triggers;
+  uint32_t fetches;
+  uint32_t fetchErrors;
+  uint32_t beats;
+  uint32_t blocks;
+  uint64_t busyCycles;
+};
+
+// Peripheral trigger (TRIGSRC) -> every enabled channel listening gets a pending trigger
+void simDMACTrigger(uint8_t triggerSource);
+
+// Event input (CHEVCTRL.EVIE) -> same as a trigger for the default action
+void simDMACEvent(int16_t channelIndex);
+
+// Bus error on the next beat of the channel (TERR path)
+void simDMACInjectError(int16_t channelIndex);
+
+// Catches the DMAC up to the sim clock (called by simAdvance)
+void simDMACRun(uint64_t now);
+
+// Advances the clock until no channel has work or maxCycles went by -> false on timeout
+bool simDMACRunUntilIdle(uint32_t maxCycles);
+
+bool simDMACIdle();
+
+bool simDMACGetStats(int16_t channelIndex, SimDMACStats &snapshot);
+
+void simDMACClearStats();
+
+// Hardware reset (registers & model state)
+void simDMACReset();
@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> SIM REGISTER FIELDS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <stdint.h>
+
+// Called after every write to a hooked register w the value before & the full value written
+// (read-modify-write merged). Hook decides what the register ends up holding.
+typedef void (*SimHook)(void *reg, uint32_t previous, uint32_t written);
+
+// Stands in for one CMSIS bit-field (or the whole .reg). Every field of a register sits in the
+// same union & starts w the same storage -> writes through .bit.X are seen by .reg & the other
+// way around, like the real register. Note -> storage is accessed volatile so spin loops re-read.
+template<typename T, unsigned POS, unsigned WIDTH, SimHook HOOK = nullptr>
+struct SimField {
+  T value;
+
+  static constexpr T MASK = (T)((((uint64_t)1 << WIDTH) - 1) << POS);
+
+  T raw() const { return *(const volatile T*)&value; }
+
+  void store(T next) { *(volatile T*)&value = next; }
+
+  operator T() const { return (T)((raw() & MASK) >> POS); }
+
+  SimField &operator=(T fieldValue) {
+    T previous = raw();
+    T written = (T)((previous & ~MASK) | (((uint64_t)fieldValue << POS) & MASK));
+    store(written);
+    if (HOOK != nullptr) HOOK(this, previous, written);
+    return *this;
+  }
+
+  SimField &operator=(const SimField &other) { return *this = (T)other; }
+
+  SimField &operator|=(T fieldValue) { return *this = (T)(*this | fieldValue); }
+
+  SimField &operator&=(T fieldValue) { return *this = (T)(*this & fieldValue); }
+};
+
+// Bit-field struct that reads like CMSIS (desc.BTCTRL.bit.VALID) -> plain storage, no hooks
+#define SIM_REG_UNION(NAME, TYPE, ...)  \
+  typedef union {                       \
+    struct { __VA_ARGS__ } bit;         \
+    TYPE reg;                           \
+  } NAME
@@ -0,0 +1,120 @@
+#include <Arduino.h>
+
+static SimUSBInBank inBank;
+static bool zlpPending = false;
+static SimUSBStats stats;
+static SimUSBTransferCallback transferCB = nullptr;
+
+static uint8_t hostBuffer[SIM_USB_HOST_TRANSFER];
+static uint32_t hostFill = 0;
+
+static void updateLine() {
+  simSetIRQLevel(USB_3_IRQn, inBank.TRCPT1 && inBank.TRCPT1_ENABLED);
+}
+
+static void completeTransfer() {
+  stats.transfers++;
+  uint32_t length = hostFill;
+  hostFill = 0;
+  if (transferCB != nullptr) transferCB(hostBuffer, length);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> IN BANK
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void simUSBArmIn(uint32_t address, uint16_t byteCount, bool autoZLP) {
+  inBank.ADDR = address;
+  inBank.BYTE_COUNT = byteCount;
+  inBank.MULTI_PACKET_SIZE = 0;
+  inBank.AUTO_ZLP = autoZLP;
+  inBank.TRCPT1 = false;
+  inBank.TRCPT1_ENABLED = true;
+  inBank.BK1RDY = true;
+  zlpPending = autoZLP && byteCount % SIM_USB_PACKET_SIZE == 0;
+  updateLine();
+}
+
+void simUSBClearTRCPT1() {
+  inBank.TRCPT1 = false;
+  updateLine();
+}
+
+void simUSBDisarmIn() {
+  inBank.BK1RDY = false;
+  inBank.TRCPT1_ENABLED = false;
+  inBank.TRCPT1 = false;
+  zlpPending = false;
+  updateLine();
+}
+
+const SimUSBInBank &simUSBGetInBank() { return inBank; }
+
+void USB_SetHandler(void (*handler)(void)) {
+  simSetVector(USB_3_IRQn, handler);
+  NVIC_EnableIRQ(USB_3_IRQn);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> HOST SIDE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void simUSBSetTransferCallback(SimUSBTransferCallback callback) { transferCB = callback; }
+
+// One IN token -> one packet from the bank (or NAK). Handler runs as soon as the bank is done,
+// so the next token may already see the re-armed bank.
+uint32_t simUSBHostPoll(uint32_t maxTokens) {
+  uint32_t moved = 0;
+  for (uint32_t i = 0; i < maxTokens; i++) {
+    if (!inBank.BK1RDY) {
+      stats.naks++;
+      break;
+    }
+    uint32_t remaining = inBank.BYTE_COUNT - inBank.MULTI_PACKET_SIZE;
+    uint32_t length = remaining < SIM_USB_PACKET_SIZE ? remaining : SIM_USB_PACKET_SIZE;
+    if (length == 0) zlpPending = false;
+
+    // Host buffer full -> packet would overflow it, close the transfer first
+    if (hostFill + length > SIM_USB_HOST_TRANSFER) completeTransfer();
+    memcpy(hostBuffer + hostFill, (const uint8_t*)(uintptr_t)inBank.ADDR
+      + inBank.MULTI_PACKET_SIZE, length);
+    hostFill += length;
+    inBank.MULTI_PACKET_SIZE += length;
+    simAdvance(SIM_USB_PACKET_CYCLES);
+
+    stats.packets++;
+    stats.bytes += length;
+    if (length < SIM_USB_PACKET_SIZE) stats.shortPackets++;
+    if (length == 0) stats.zlps++;
+    if (length < SIM_USB_PACKET_SIZE || hostFill == SIM_USB_HOST_TRANSFER) completeTransfer();
+    moved++;
+
+    // Bank done -> ZLP still owed after a full last packet
+    if (inBank.MULTI_PACKET_SIZE == inBank.BYTE_COUNT && !zlpPending) {
+      inBank.BK1RDY = false;
+      inBank.TRCPT1 = true;
+      updateLine();
+    }
+  }
+  return moved;
+}
+
+void simUSBHostFlush() {
+  if (hostFill > 0) completeTransfer();
+}
+
+bool simUSBGetStats(SimUSBStats &snapshot) {
+  snapshot = stats;
+  return true;
+}
+
+void simUSBClearStats() { memset(&stats, 0, sizeof(stats)); }
+
+void simUSBReset() {
+  memset(&inBank, 0, sizeof(inBank));
+  zlpPending = false;
+  hostFill = 0;
+  transferCB = nullptr;
+  simUSBClearStats();
+  updateLine();
+}
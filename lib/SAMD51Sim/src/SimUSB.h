@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> SIM USB (BULK IN ENDPOINT MODEL)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <stdint.h>
+#include <SimCore.h>
+
+// Full speed bulk -> at most ~19 packets per 1 ms frame
+#define SIM_USB_PACKET_SIZE 64
+#define SIM_USB_PACKET_CYCLES (SIM_CYCLES_PER_MICRO * 1000 / 19)
+#define SIM_USB_HOST_TRANSFER 16384   // Bytes the host asks for per IN transfer (one URB)
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> IN BANK (DEVICE SIDE)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Bank 1 of the IN endpoint as the driver programs it -> names as the endpoint descriptor.
+// The bank sends BYTE_COUNT bytes from ADDR as 64 byte packets (last one short) & a ZLP after
+// a full last packet if AUTO_ZLP is set, then clears BK1RDY & sets TRCPT1.
+struct SimUSBInBank {
+  uint32_t ADDR;
+  uint16_t BYTE_COUNT;
+  uint16_t MULTI_PACKET_SIZE;   // Bytes sent so far
+  bool AUTO_ZLP;
+  bool BK1RDY;
+  bool TRCPT1;
+  bool TRCPT1_ENABLED;
+};
+
+// Same as the driver's armNext() -> descriptor fields, clear & enable TRCPT1, set BK1RDY
+void simUSBArmIn(uint32_t address, uint16_t byteCount, bool autoZLP);
+
+// Same as writing EPINTFLAG.TRCPT1 -> drops the interrupt line
+void simUSBClearTRCPT1();
+
+// Same as writing EPSTATUSCLR.BK1RDY & EPINTENCLR.TRCPT1 (abort)
+void simUSBDisarmIn();
+
+const SimUSBInBank &simUSBGetInBank();
+
+// As the core -> handler runs on USB_3_IRQn (TRCPT1)
+void USB_SetHandler(void (*handler)(void));
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> HOST SIDE (BENCH)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Host view -> a transfer ends on a short packet, a ZLP or a full host buffer
+struct SimUSBStats {
+  uint32_t packets;
+  uint32_t shortPackets;    // Incl. ZLPs
+  uint32_t zlps;
+  uint32_t naks;            // IN tokens w no bank ready
+  uint32_t transfers;
+  uint64_t bytes;
+};
+
+typedef void (*SimUSBTransferCallback)(const uint8_t *data, uint32_t length);
+
+// Called w each completed host transfer (data valid during the call only)
+void simUSBSetTransferCallback(SimUSBTransferCallback callback);
+
+// Host sends up to maxTokens IN tokens, stops at the first NAK. Each packet advances the clock
+// by SIM_USB_PACKET_CYCLES. Returns packets moved.
+uint32_t simUSBHostPoll(uint32_t maxTokens);
+
+// Ends the open host transfer (e.g. host side timeout) -> delivers what it holds
+void simUSBHostFlush();
+
+bool simUSBGetStats(SimUSBStats &snapshot);
+
+void simUSBClearStats();
+
+// Bank, host transfer & stats back to reset state
+void simUSBReset();
@@ -6,23 +6,81 @@
 
 static Adc *instances[BOARD_ADC_MODULE_COUNT] = ADC_INSTS;
 
-static uint16_t ADC_DATA_BUFFER[BOARD_ADC_MODULE_COUNT][ADC_DB_LENGTH] = {};
-static uint16_t ADC_DB_SIZE = sizeof(ADC_DATA_BUFFER[0]);
-static uint16_t ADC_DBVAL_SIZE = sizeof(ADC_DATA_BUFFER[0][0]);
+// Data & split buffers are carved from here unless the user provides one. Aligned (as is every
+// slot) so stream blocks can be handed to the USB endpoint as-is
+static __attribute__((__aligned__(ADC_DB_ALIGNMENT))) 
+  uint16_t ADC_ARENA[ADC_ARENA_LENGTH] = {};
+static uint16_t ADC_DBVAL_SIZE = sizeof(ADC_ARENA[0]);
+
+struct ArenaSlot {
+  uint32_t offset;
+  uint32_t length;              // Free if 0
+};
+static ArenaSlot arenaSlots[ADC_ARENA_SLOTS] = {};
 
 struct ADCInfo {
   DMA_TRIGGER dataTrigger;
   DMA_TRIGGER ctrlTrigger;
   uint8_t clockID;
   IRQn_Type baseIRQ;
+  uint8_t startUser;
 };
 
 static ADCInfo ADC_REF[BOARD_ADC_MODULE_COUNT] {
-  {TRIGGER_ADC0_RESRDY, TRIGGER_ADC0_SEQ, ADC0_GCLK_ID, ADC0_0_IRQn},
-  {TRIGGER_ADC1_RESRDY, TRIGGER_ADC1_SEQ, ADC1_GCLK_ID, ADC1_0_IRQn} 
+  {TRIGGER_ADC0_RESRDY, TRIGGER_ADC0_SEQ, ADC0_GCLK_ID, ADC0_0_IRQn, EVSYS_ID_USER_ADC0_START},
+  {TRIGGER_ADC1_RESRDY, TRIGGER_ADC1_SEQ, ADC1_GCLK_ID, ADC1_0_IRQn, EVSYS_ID_USER_ADC1_START} 
 };
 
-static ADCModule *modules[] = { nullptr };
+static ADCModule *modules[BOARD_ADC_MODULE_COUNT] = { nullptr, nullptr };
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> ADC BUFFER ARENA
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// First fit -> candidate is bumped past every slot it overlaps until it lands in a gap. Only a 
+// handful of slots so no free list, lengths rounded up to keep each slot aligned.
+static uint16_t *arenaAlloc(uint32_t sampleCount) {
+  const uint32_t align = ADC_DB_ALIGNMENT / sizeof(ADC_ARENA[0]);
+  uint32_t length = ((sampleCount + align - 1) / align) * align;
+  int16_t freeSlot = -1;
+
+  for (int16_t i = 0; i < ADC_ARENA_SLOTS; i++) {
+    if (arenaSlots[i].length == 0) {
+      freeSlot = i;
+      break;
+    }
+  }
+  if (freeSlot == -1 || length == 0) return nullptr;
+
+  uint32_t offset = 0;
+  bool moved = true;
+  while (moved) {
+    moved = false;
+    for (int16_t i = 0; i < ADC_ARENA_SLOTS; i++) {
+      const ArenaSlot &slot = arenaSlots[i];
+      if (slot.length != 0 && offset < slot.offset + slot.length 
+       && slot.offset < offset + length) {
+        offset = slot.offset + slot.length;
+        moved = true;
+      }
+    }
+  }
+  if (offset + length > ADC_ARENA_LENGTH) return nullptr;
+
+  arenaSlots[freeSlot] = { offset, length };
+  memset(ADC_ARENA + offset, 0, length * sizeof(ADC_ARENA[0]));
+  return ADC_ARENA + offset;
+}
+
+// Note -> anything outside the arena (user buffers, nullptr) is ignored
+static void arenaFree(uint16_t *buffer) {
+  for (int16_t i = 0; i < ADC_ARENA_SLOTS; i++) {
+    if (arenaSlots[i].length != 0 && ADC_ARENA + arenaSlots[i].offset == buffer) {
+      arenaSlots[i].length = 0;
+      return;
+    }
+  }
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> ADC INTERRUPT
@@ -30,7 +88,11 @@ static ADCModule *modules[] = { nullptr };
 
 // Common interrupt handler
 void ADCCommonHandler(ADCModule *source) {
+  if (source == nullptr) return;
   source->adc->INTFLAG.bit.WINMON = 1;
+  if (source->captureState == CAPTURE_ARMED) {
+    source->triggerCapture();
+  }
   if (source->windowCB != nullptr) {
     source->windowCB();
   }
@@ -38,18 +100,32 @@ void ADCCommonHandler(ADCModule *source) {
 
 // Module specific interrupts
 void ADC0Handler(void) { ADCCommonHandler(modules[0]); }
-void ADC1Handler(void) { ADCCommonHandler(modules[0]); }
+void ADC1Handler(void) { ADCCommonHandler(modules[1]); }
 
-// Inerrupt aliases
-void ADC0Handler(void) __attribute__((weak, alias("ADC0_0_Handler")));
-void ADC0Handler(void) __attribute__((weak, alias("ADC0_1_Handler")));
-void ADC1Handler(void) __attribute__((weak, alias("ADC1_0_Handler")));
-void ADC1Handler(void) __attribute__((weak, alias("ADC1_1_Handler")));
+// Inerrupt aliases -> both vectors of a module share one handler
+void ADC0_0_Handler(void) __attribute__((alias("ADC0Handler")));
+void ADC0_1_Handler(void) __attribute__((alias("ADC0Handler")));
+void ADC1_0_Handler(void) __attribute__((alias("ADC1Handler")));
+void ADC1_1_Handler(void) __attribute__((alias("ADC1Handler")));
 
 
 void dataDMACallback (DMA_CALLBACK_REASON reason, TransferChannel &source, 
 int16_t descriptorIndex) {
 
+  // Stream reached a held block (invalid descriptor) -> DMAC suspended, samples are lost until
+  // releaseBlock resumes it
+  if (reason == REASON_ERROR && source.getError() == ERROR_DMA_DESCRIPTOR) {
+    for (int16_t i = 0; i < BOARD_ADC_MODULE_COUNT; i++) {
+      ADCModule *targ = modules[i];
+      if (targ != nullptr && targ->dataChannel == &source && targ->streamEnabled) {
+        targ->stalled = true;
+        targ->stallStart = micros();
+        targ->stallCount++;
+      }
+    }
+    return;
+  }
+
   if (reason == REASON_TRANSFER_COMPLETE_SUSPENDED 
    || reason == REASON_TRANSFER_COMPLETE_STOPPED) {
 
@@ -57,6 +133,37 @@ int16_t descriptorIndex) {
       ADCModule *targ = modules[i];
       if (targ != nullptr && targ->moduleNumber == source.getOwnerID()) {
 
+        // Capture -> stop segment reached, history & post trigger samples are frozen
+        if (targ->captureState == CAPTURE_TRIGGERED) {
+          targ->captureState = CAPTURE_DONE;
+          if (targ->captureCB != nullptr) targ->captureCB(*targ);
+          continue;
+        }
+
+        // Interleaved pair -> samples live in ADC0's blocks, its callback covers both
+        if (targ->streamEnabled && targ->pairInterleaved) {
+          targ->blockCount++;
+          continue;
+        }
+
+        // Streaming -> every block the DMAC finished since the last pass (writeback, not a count
+        // of interrupts -> a late ISR covering 2 blocks still hands out both)
+        if (targ->streamEnabled) {
+          int16_t blockLength = targ->DBLength / ADC_STREAM_DESC_COUNT;
+          int16_t half;
+          while ((half = targ->streamQueue.collect(source)) != -1) {
+            targ->stableHalf = half;
+            targ->blockCount++;
+
+            // Split -> callback fires once the block is sorted into per pin arrays
+            if (targ->splitEnabled) {
+              targ->startSplit(half);
+            } else if (targ->streamCB != nullptr) {
+              targ->streamCB(*targ, targ->DB + half * blockLength, blockLength, half);
+            }
+          }
+          continue;
+        }
         targ->DBIndex += targ->dataTransferSize;
 
         if (targ->DBIndex + targ->dataTransferSize > targ->DBLength) {         ////////// NEED TO FIGURE THIS OUT...
@@ -72,24 +179,36 @@ int16_t descriptorIndex) {
 
 }
 
+void splitDMACallback (DMA_CALLBACK_REASON reason, TransferChannel &source, 
+int16_t descriptorIndex) {
+  if (reason != REASON_TRANSFER_COMPLETE_STOPPED) return;
+
+  for (int16_t i = 0; i < BOARD_ADC_MODULE_COUNT; i++) {
+    ADCModule *targ = modules[i];
+    if (targ != nullptr && targ->splitChannel == &source && targ->streamCB != nullptr) {
+      targ->streamCB(*targ, targ->splitDB, targ->getBlockLength(), targ->splitHalf);
+    }
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> ADC MODULE CLASS (PUBLIC METHODS)
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-ADCModule::ADCModule(uint8_t moduleNumber) 
-  : moduleNumber(MAX(moduleNumber, BOARD_ADC_MODULE_COUNT - 1)) {
+ADCModule::ADCModule(uint8_t moduleNum) 
+  : moduleNumber(MIN(moduleNum, BOARD_ADC_MODULE_COUNT - 1)) {
 
-  MAX(moduleNumber, BOARD_ADC_MODULE_COUNT - 1);
   adc = instances[moduleNumber];
   adcNum = moduleNumber;
-  DB = ADC_DATA_BUFFER[moduleNumber];
+  DB = nullptr;
+  splitDB = nullptr;
 
   resetFields();
   settings.setDefault();
 }
 
 bool ADCModule::begin() {
-  if (!currentState) return true;
+  if (currentState) return true;
   if (modules[adcNum] != nullptr) return false;
 
   // Reset ADC & configure module
@@ -103,6 +222,14 @@ bool ADCModule::begin() {
   resetFields();
   settings.setDefault();
 
+  // Default buffer -> resize w/ setBufferLength or replace w/ setBuffer
+  DB = arenaAlloc(ADC_DB_LENGTH);
+  if (DB == nullptr) {
+    currentError = ERROR_ADC_SYS;
+    return false;
+  }
+  DBLength = ADC_DB_LENGTH;
+
   if (!setDescDefault()) return false;
   if (!initDMA()) return false;
 
@@ -121,6 +248,8 @@ void ADCModule::end(bool blocking) {
   if (currentState == 0) return;
 
   exitDMA(blocking); 
+  exitTimerTrigger();
+  freeTimer();
 
   // Disable ADC
   adc->CTRLA.bit.ENABLE = 0;
@@ -174,6 +303,8 @@ bool ADCModule::enable() {
   while(syncBusy()); 
 
   // Configure pins
+  ctrlIndex = 0;
+  activePins = 0;
   for (int16_t i = 0; i < pinCount; i++) {
 
     if (pins[i] < PINS_COUNT) {
@@ -210,6 +341,26 @@ bool ADCModule::enable() {
     
   }
 
+  // Paired -> ADC1 converts on ADC0's start (checked first, stream layout depends on it)
+  if (!initPair()) return false;
+
+  // Capture -> looped segments, window interrupt sets where they stop
+  if (captureEnabled) {
+    if (!initCapture()) return false;
+
+  // If streaming -> swap in the looped block descriptors
+  } else if (streamEnabled) {
+    if (!initStream()) return false;
+    if (splitEnabled && !initSplit()) return false;
+    stalled = false;
+    stallCount = 0;
+    stallMicros = 0;
+    samplesLost = 0;
+  }
+
+  // Timer paced -> conversions wait for the overflow event instead of chaining
+  if (!pairEnabled && !initTimerTrigger()) return false;
+
   // Start the DMA Channel
   dataChannel->enableExternalTrigger();
   dataChannel->setAllValid(true);
@@ -224,15 +375,21 @@ bool ADCModule::enable() {
   adc->CTRLA.bit.ENABLE = 1;
   while(adc->SYNCBUSY.bit.ENABLE);
 
-  adc->SWTRIG.bit.START = 1;
-  while(adc->SYNCBUSY.bit.SWTRIG);
-
+  if (pairEnabled) {
+    // Nothing to start -> follows ADC0
+  } else if (triggerTimer == -1) {
+    adc->SWTRIG.bit.START = 1;
+    while(adc->SYNCBUSY.bit.SWTRIG);
+  } else if (ownsTimer) {
+    System.tim.start(triggerTimer);
+  }
   currentState = 2;
   return true;
 }
 
 void ADCModule::disable() {
   if (currentState == 0 || currentState == 1) return;
+  if (ownsTimer) System.tim.stop(triggerTimer);
 
   // Disable ADC & DMA
   adc->CTRLA.bit.ENABLE = 0;
@@ -240,10 +397,14 @@ void ADCModule::disable() {
 
   dataChannel->disable(false);
   ctrlChannel->disable(false);
+  exitTimerTrigger();
+  exitPair();
+  exitCapture();
 
   if (currentState == 2) {
     flushBuffer();
     memset(ctrlInput, 0, sizeof(ctrlInput));
+    stableHalf = -1;
   }
 
   // Clear pending interrupts
@@ -281,15 +442,15 @@ void ADCModule::flushBuffer() {
     __DSB();
   }
   // Flush using index or querey values @ increments
-  if (DBIndex > 0) {
-    memset(DB, 0, MAX(DBIndex + ADC_DEFAULT_DB_OVERCLEAR, ADC_DB_LENGTH) * ADC_DBVAL_SIZE);
+  if (DB == nullptr) {
+    // Nothing to flush
+  } else if (DBIndex > 0) {
+    memset(DB, 0, MIN(DBIndex + ADC_DEFAULT_DB_OVERCLEAR, DBLength) * ADC_DBVAL_SIZE);
     DBIndex = 0;
   } else {
-    int16_t maxIndex;
-    for (int16_t i = 0; i < ADC_DB_LENGTH; i += ADC_DB_INCREMENT) {
+    for (uint32_t i = 0; i < DBLength; i += ADC_DB_INCREMENT) {
       if (DB[i] != 0) {
-        maxIndex = i;
-        memset(DB + i * ADC_DB_INCREMENT, 0, ADC_DB_INCREMENT * ADC_DBVAL_SIZE);
+        memset(DB + i, 0, MIN(ADC_DB_INCREMENT, DBLength - i) * ADC_DBVAL_SIZE);
       } else {
         break;
       }
@@ -303,6 +464,121 @@ void ADCModule::flushBuffer() {
   }
 }
 
+int16_t ADCModule::getStableHalf() { return stableHalf; }
+
+uint32_t ADCModule::getBlockCount() { return blockCount; }
+
+// Actual rate of the pacing timer, 0 while free running (rate set by prescaler/sample settings)
+float ADCModule::getSampleRate() {
+  return (triggerTimer == -1) ? 0 : System.tim.getRate(triggerTimer);
+}
+
+// Reader side of the block queue -> samples are read in place from DB, never copied. Only the
+// main loop calls these, the ISR only appends block indices.
+uint32_t ADCModule::samplesAvailable() { return streamQueue.samplesAvailable(); }
+
+// Returns a view of the oldest samples (up to the end of their block) -> call commitSamples()
+// when done
+uint32_t ADCModule::peekSamples(uint16_t *&samples) { return streamQueue.peekSamples(samples); }
+
+void ADCModule::commitSamples(uint32_t sampleCount) { streamQueue.commitSamples(sampleCount); }
+
+uint32_t ADCModule::getOverruns() { return streamQueue.getOverruns(); }
+
+ADC_CAPTURE_STATE ADCModule::getCaptureState() { return captureState; }
+
+// Lets the frozen channel run on from the stop segment -> history refills before the next one
+bool ADCModule::rearmCapture() {
+  if (captureState != CAPTURE_DONE) return false;
+
+  dataChannel->setDescriptorAction(stopSegment, ACTION_NONE);
+  stopSegment = -1;
+  captureState = CAPTURE_ARMED;
+  adc->INTFLAG.reg = ADC_INTFLAG_WINMON;
+  adc->INTENSET.reg = ADC_INTENSET_WINMON;
+  return dataChannel->resume();
+}
+
+// Unrolls the ring -> preSamples of history, then the trigger sample & what followed it
+uint32_t ADCModule::readCapture(uint16_t *destination, uint32_t maxSamples) {
+  if (captureState != CAPTURE_DONE || destination == nullptr) return 0;
+
+  uint32_t count = MIN(getCaptureLength(), maxSamples);
+  uint32_t start = (triggerIndex + DBLength - capturePre) % DBLength;
+  uint32_t first = MIN(count, DBLength - start);
+
+  memcpy(destination, DB + start, first * ADC_DBVAL_SIZE);
+  memcpy(destination + first, DB, (count - first) * ADC_DBVAL_SIZE);
+  return count;
+}
+
+uint32_t ADCModule::getCaptureLength() { return capturePre + capturePost; }
+
+uint16_t *ADCModule::getBlock(int16_t blockIndex) {
+  if (blockIndex < 0 || blockIndex >= ADC_STREAM_DESC_COUNT) return nullptr;
+  return DB + blockIndex * getBlockLength();
+}
+
+int16_t ADCModule::getBlockLength() { return DBLength / ADC_STREAM_DESC_COUNT; }
+
+// Split mode only -> samples of the pin @ pinIndex (scan order) from the last block
+uint16_t *ADCModule::getPinBlock(int16_t pinIndex) {
+  if (!splitEnabled || splitDB == nullptr || pinIndex < 0 || pinIndex >= activePins) {
+    return nullptr;
+  }
+  return splitDB + pinIndex * getPinBlockLength();
+}
+
+int16_t ADCModule::getPinBlockLength() {
+  return activePins > 0 ? getBlockLength() / activePins : 0;
+}
+
+bool ADCModule::getSplitEnabled() { return splitEnabled; }
+
+// Stream blocks that never reached the callback in split mode (split DMA still busy w the last)
+uint32_t ADCModule::getSplitDrops() { return splitDrops; }
+
+// Invalidates the block's descriptor -> DMAC suspends instead of overwriting it while it is read
+// Note -> DMAC reaches a held block after filling the other ADC_STREAM_DESC_COUNT - 1, hold it
+// longer & the stream stalls -> conversions are lost until release (see getSamplesLost)
+bool ADCModule::holdBlock(int16_t blockIndex) {
+  if (!streamEnabled || currentState != 2 
+  || blockIndex < 0 || blockIndex >= ADC_STREAM_DESC_COUNT) {
+    return false;
+  }
+  return dataChannel->setDescriptorValid(blockIndex, false);
+}
+
+bool ADCModule::releaseBlock(int16_t blockIndex) {
+  if (!streamEnabled || currentState != 2 
+  || blockIndex < 0 || blockIndex >= ADC_STREAM_DESC_COUNT) {
+    return false;
+  }
+  if (!dataChannel->setDescriptorValid(blockIndex, true)) return false;
+
+  // If DMAC reached the held block it suspended (fetch error) -> resume it, book the gap
+  if (dataChannel->getStatus() == DMA_CHANNEL_SUSPENDED) {
+    if (stalled) {
+      uint32_t elapsed = micros() - stallStart;
+      stalled = false;
+      stallMicros += elapsed;
+      samplesLost += (uint32_t)((float)elapsed * getSampleRate() / 1000000.0f);
+    }
+    dataChannel->resume();
+  }
+  return true;
+}
+
+// Times the DMAC ran into a held block & stopped (see holdBlock)
+uint32_t ADCModule::getStalls() { return stallCount; }
+
+// Total time stalled (to the resume in releaseBlock)
+uint32_t ADCModule::getStallMicros() { return stallMicros; }
+
+// Conversions that had nowhere to go while stalled -> stall time x paced rate, so only counted
+// w a trigger timer (free running rate is unknown, see getStallMicros)
+uint32_t ADCModule::getSamplesLost() { return samplesLost; }
+
 bool ADCModule::syncBusy() {
   return (dataChannel->syncBusy() || ctrlChannel->syncBusy());
 }
@@ -356,6 +632,121 @@ ADCModule::ADCSettings &ADCModule::ADCSettings::setAutoStopConfig(bool enabled,
   return *this;
 }
 
+ADCModule::ADCSettings &ADCModule::ADCSettings::setStreamConfig(bool enableStreaming,
+  ADCStreamCallback callback) {
+
+  if (super->currentState == 1) {
+    super->streamEnabled = enableStreaming;
+    super->streamCB = enableStreaming ? callback : nullptr;
+  }
+  return *this;
+}
+
+// Streaming only -> stream callback gets per pin arrays (see getPinBlock) instead of the
+// interleaved scan, peekSamples still reads the interleaved samples.
+// Note -> active pin count must be a power of two up to ADC_SPLIT_MAX_PINS
+ADCModule::ADCSettings &ADCModule::ADCSettings::setSplitConfig(bool splitByPin) {
+  if (super->currentState == 1) {
+    super->splitEnabled = splitByPin;
+  }
+  return *this;
+}
+
+// Each overflow of the timer (see System.tim) starts one conversion, so a DAC paced by the same
+// timer gives sample k of the capture a fixed phase against stimulus sample k.
+// Note -> one conversion per event, a scan of N pins samples each pin @ rate / N. Events that
+// land while a conversion is still running are lost -> keep the rate under the conversion rate.
+ADCModule::ADCSettings &ADCModule::ADCSettings::setTimerTrigger(int16_t timer) {
+  if (super->currentState == 1) {
+    super->freeTimer();
+    super->triggerTimer = (timer < 0) ? -1 : timer;
+  }
+  return *this;
+}
+
+// Oscilloscope style -> buffer runs as a ring until the window monitor fires (see 
+// setWindowModeConfig), then the DMAC stops itself once postSamples more have landed. The trigger
+// sample is the first of the post samples. Replaces streaming while enabled.
+// Note -> preSamples + postSamples + 2 segments (buffer / ADC_CAPTURE_DESC_COUNT) + margin
+// must fit in the buffer
+ADCModule::ADCSettings &ADCModule::ADCSettings::setCaptureConfig(bool enableCapture, 
+  uint32_t preSamples, uint32_t postSamples, ADCCaptureCallback callback) {
+  if (super->currentState == 1) {
+    super->captureEnabled = enableCapture;
+    super->capturePre = preSamples;
+    super->capturePost = MAX(postSamples, (uint32_t)1);
+    super->captureCB = callback;
+  }
+  return *this;
+}
+
+// User owned buffer -> must outlive the module (or the next setBuffer call). Stream blocks are
+// 1 / ADC_STREAM_DESC_COUNT of the buffer each, so fewer interrupts the bigger it is.
+// Note -> sample count must be a multiple of ADC_STREAM_DESC_COUNT, at most ADC_MAX_DB_LENGTH
+ADCModule::ADCSettings &ADCModule::ADCSettings::setBuffer(uint16_t *buffer, 
+  uint32_t sampleCount) {
+  if (super->currentState == 1) {
+    super->initBuffer(buffer, sampleCount);
+  }
+  return *this;
+}
+
+// Same as setBuffer but carved from the static arena (ADC_ARENA_LENGTH shared by both modules)
+// Note -> at most ADC_ARENA_LENGTH, less whatever is carved already (other module, split arrays
+// & this module's old buffer, which is kept until the new one is in place)
+ADCModule::ADCSettings &ADCModule::ADCSettings::setBufferLength(uint32_t sampleCount) {
+  if (super->currentState != 1) return *this;
+  if (sampleCount > ADC_ARENA_LENGTH) {
+    super->currentError = ERROR_ADC_SYS;
+    return *this;
+  }
+  // Old buffer kept until the new one is in place -> nothing changes if the arena is full
+  uint16_t *buffer = arenaAlloc(sampleCount);
+  if (buffer == nullptr) {
+    super->currentError = ERROR_ADC_SYS;
+  } else if (!super->initBuffer(buffer, sampleCount)) {
+    arenaFree(buffer);
+  }
+  return *this;
+}
+
+// ADC1 only -> slaved to ADC0 (CTRLA.SLAVEEN), each ADC0 start converts on both modules at once,
+// so pin scans line up sample for sample (I/Q). Interleave puts ADC1's results between ADC0's
+// in ADC0's stream blocks (I0 Q0 I1 Q1...) -> ADC0's callback/reader see the pair.
+// Note -> enable ADC1 first, then ADC0. Interleave needs streaming on both, no split mode.
+ADCModule::ADCSettings &ADCModule::ADCSettings::setPairConfig(bool pairWithADC0,
+  bool interleave) {
+  if (super->currentState == 1 && super->adcNum == 1) {
+    super->pairEnabled = pairWithADC0;
+    super->pairInterleaved = pairWithADC0 && interleave;
+  }
+  return *this;
+}
+
+// Paces conversions from a timer of its own (see setTimerTrigger) -> period is an integer count
+// of the timer clock, so the closest achievable rate is used. Read it back w/ getSampleRate().
+// Note -> 0 returns to free running
+ADCModule::ADCSettings &ADCModule::ADCSettings::setSampleRate(float hz) {
+  if (super->currentState != 1) return *this;
+
+  if (hz <= 0) {
+    super->freeTimer();
+    super->triggerTimer = -1;
+    return *this;
+  }
+  if (!super->ownsTimer) {
+    int16_t timer = System.tim.allocTimer();
+    if (timer == -1) {
+      super->currentError = ERROR_ADC_TRIGGER;
+      return *this;
+    }
+    super->triggerTimer = timer;
+    super->ownsTimer = true;
+  }
+  System.tim.setRate(super->triggerTimer, MIN(hz, (float)ADC_MAX_SAMPLE_RATE));
+  return *this;
+}
+
 ADCModule::ADCSettings &ADCModule::ADCSettings::setPrescaler(uint8_t clockDivisor) {
   uint8_t regVal = log2(clockDivisor);
   CLAMP(regVal, 0, ADC_CLOCK_DIVISOR_MAX);
@@ -546,10 +937,10 @@ ADCModule::ADCSettings &ADCModule::ADCSettings::setPriorityLvl(uint8_t priorityL
 
 ADCModule::ADCSettings &ADCModule::ADCSettings::setDataTransferSize(
   uint16_t numBytes) {
-  CLAMP(numBytes, 0, ADC_DATA_TRANSFER_MAX_SIZE);
-  
   if (super->currentState == 1) {
-    super->dataTransferSize = numBytes;
+    super->dataTransferSize = CLAMP(numBytes, (uint16_t)1, 
+      (uint16_t)MIN(super->DBLength, (uint32_t)UINT16_MAX));
+    super->initBuffer(super->DB, super->DBLength);
   }
   return *this;
 }
@@ -581,6 +972,16 @@ void ADCModule::ADCSettings::setDefault() {
   super->erChannel = 0;
   super->erDAC = nullptr;
   super->erType = 0;
+  super->streamEnabled = ADC_DEFAULT_STREAM_ENABLED;
+  super->streamCB = nullptr;
+  super->splitEnabled = ADC_DEFAULT_SPLIT_ENABLED;
+  super->triggerTimer = ADC_DEFAULT_TRIGGER_TIMER;
+  super->pairEnabled = ADC_DEFAULT_PAIR_ENABLED;
+  super->pairInterleaved = false;
+  super->captureEnabled = ADC_DEFAULT_CAPTURE_ENABLED;
+  super->capturePre = 0;
+  super->capturePost = 1;
+  super->captureCB = nullptr;
 
   // TO COMPLETE....
 }
@@ -590,10 +991,18 @@ void ADCModule::ADCSettings::setDefault() {
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool ADCModule::initDMA() {
-  // Allocate new channels
-  dataChannel = DMA.allocateChannel(adcNum);
-  ctrlChannel = DMA.allocateChannel(adcNum);
-  if (dataChannel != nullptr && ctrlChannel != nullptr) return false;
+  // Allocate new channels -> data channel must never lose arbitration (overrun)
+  DMAChannelRequest dataRequest = { adcNum, SUBSYSTEM_ADC, CLASS_REALTIME,
+    ADC_REF[adcNum].dataTrigger, ADC_DMA_BANDWIDTH, false, false };
+  DMAChannelRequest ctrlRequest = { adcNum, SUBSYSTEM_ADC, (DMA_PRIORITY_CLASS)priorityLvl,
+    ADC_REF[adcNum].ctrlTrigger, 0, false, false };
+  dataChannel = DMAUtility::allocateChannel(dataRequest);
+  ctrlChannel = DMAUtility::allocateChannel(ctrlRequest);
+  if (dataChannel == nullptr || ctrlChannel == nullptr) {
+    DMA.freeChannel(dataChannel);
+    DMA.freeChannel(ctrlChannel);
+    return false;
+  }
 
   // Get channel numbers
   dataChNum = dataChannel->getChannelNum();
@@ -605,8 +1014,7 @@ bool ADCModule::initDMA() {
     .setTriggerAction(ACTION_TRANSFER_BURST)
     .setCallbackFunction(&dataDMACallback)
     .setCallbackConfig(false, false, true)
-    .setDescriptorsLooped(true, false)
-    .setPriorityLevel(priorityLvl);
+    .setDescriptorsLooped(true, false);
 
   ctrlChannel->settings
     .setExternalTrigger(ADC_REF[adcNum].ctrlTrigger)
@@ -617,7 +1025,7 @@ bool ADCModule::initDMA() {
     .setDescriptorsLooped(true, false);
 
   // Set & validate descriptors
-  dataChannel->setDescriptor(&dataDesc, true);
+  ADCLoadBuffer(*dataChannel, dataDesc, DB, dataTransferSize);
   ctrlChannel->setDescriptor(&dataDesc, true);
   dataChannel->setAllValid(true);
   ctrlChannel->setAllValid(true);
@@ -628,26 +1036,51 @@ bool ADCModule::initDMA() {
 void ADCModule::exitDMA(bool blocking) {
   dataChannel->disable(blocking);
   ctrlChannel->disable(blocking);
+  if (splitChannel != nullptr) splitChannel->disable(blocking);
 
   DMA.freeChannel(dataChannel);
   DMA.freeChannel(ctrlChannel);
+  DMA.freeChannel(splitChannel);
+  splitChannel = nullptr;
 }
 
 void ADCModule::resetFields() {                                                 /////////// TO COMPLETE
   DMA.freeChannel(dataChannel);
   DMA.freeChannel(ctrlChannel);
+  DMA.freeChannel(splitChannel);
   dataChannel = nullptr;
   ctrlChannel = nullptr;
+  splitChannel = nullptr;
   setDescDefault();
 
   memset(pins, -1, sizeof(pins));
   memset(ctrlInput, 0, sizeof(ctrlInput));
   flushBuffer();
+  arenaFree(DB);
+  arenaFree(splitDB);
+  DB = nullptr;
+  splitDB = nullptr;
 
   currentState = 0;
   for (int16_t i = 0; i < sizeof(pins); i++) pins[i] = -1;
   pinCount = 0;
   currentError = ERROR_NONE;
+  DBLength = 0;
+  stableHalf = -1;
+  blockCount = 0;
+  streamQueue.reset(nullptr, 0);
+  stalled = false;
+  stallStart = 0;
+  stallCount = 0;
+  stallMicros = 0;
+  samplesLost = 0;
+  splitHalf = -1;
+  splitDrops = 0;
+  triggerEvent = -1;
+  ownsTimer = false;
+  captureState = CAPTURE_IDLE;
+  triggerIndex = 0;
+  stopSegment = -1;
 }
 
 bool ADCModule::setDescDefault() {
@@ -656,7 +1089,7 @@ bool ADCModule::setDescDefault() {
     .setDataSize(2)
     .setIncrementConfig(false, true)
     .setTransferAmount(dataTransferSize)
-    .setDestination((uint32_t)&DB, true)
+    .setDestination((uint32_t)DB, true)
     .setSource((uint32_t)&adc->RESULT.reg, false);
 
   ctrlDesc
@@ -670,6 +1103,116 @@ bool ADCModule::setDescDefault() {
   return (ctrlDesc.isValid() && dataDesc.isValid());
 } 
 
+bool ADCModule::initStream() {
+  int16_t blockLength = DBLength / ADC_STREAM_DESC_COUNT;
+  TransferDescriptor *descList[ADC_STREAM_DESC_COUNT];
+
+  // Interleaved pair -> each module fills every other slot of ADC0's buffer
+  int16_t stride = getStreamStride();
+  uint16_t *dest = pairInterleaved ? modules[0]->DB + 1 : DB;
+
+  // Split buffer into equal blocks -> each raises an interrupt when filled (channel keeps going)
+  for (int16_t i = 0; i < ADC_STREAM_DESC_COUNT; i++) {
+    streamDesc[i]
+      .setAction(ACTION_BLOCK_INTERRUPT)
+      .setDataSize(ADC_DBVAL_SIZE)
+      .setIncrementConfig(false, true)
+      .setTransferAmount(blockLength >> stride)
+      .setIncrementModifier(DESTINATION, stride)
+      .setDestination((uint32_t)(dest + i * blockLength), true)
+      .setSource((uint32_t)&adc->RESULT.reg, false);
+    descList[i] = &streamDesc[i];
+  }
+  // Link blocks into a ring so the DMAC never stops @ the end of the buffer
+  if (!dataChannel->setDescriptors(descList, ADC_STREAM_DESC_COUNT, false, false)) {
+    currentError = ERROR_ADC_DMA;
+    return false;
+  }
+  dataChannel->settings
+    .setDescriptorsLooped(true, true)
+    .setCallbackConfig(true, true, false);
+
+  stableHalf = -1;
+  blockCount = 0;
+  streamQueue.reset(DB, blockLength);
+  return true;
+}
+
+// Memory -> memory channel, one descriptor per pin. Source steps over the interleaved block by
+// the pin count (STEPSIZE) so each pin's samples land contiguous in its own array.
+bool ADCModule::initSplit() {
+  if (activePins == 0 || activePins > ADC_SPLIT_MAX_PINS 
+  || (activePins & (activePins - 1)) != 0) {
+    currentError = ERROR_ADC_DMA;
+    return false;
+  }
+  if (splitChannel == nullptr) {
+    DMAChannelRequest request = { adcNum, SUBSYSTEM_ADC, CLASS_BACKGROUND, 
+      TRIGGER_SOFTWARE, 0, false, false };
+    splitChannel = DMAUtility::allocateChannel(request);
+    if (splitChannel == nullptr) {
+      currentError = ERROR_ADC_DMA;
+      return false;
+    }
+  }
+  // Per pin arrays of one block -> pin i @ i * getPinBlockLength()
+  if (splitDB == nullptr) {
+    splitDB = arenaAlloc(getBlockLength());
+    if (splitDB == nullptr) {
+      currentError = ERROR_ADC_SYS;
+      return false;
+    }
+  }
+  // One software trigger runs every pin's block
+  splitChannel->settings
+    .setTriggerAction(ACTION_TRANSFER_ALL)
+    .setBurstLength(DMA_TUNING_MAX_BURST)
+    .setCallbackFunction(&splitDMACallback)
+    .setCallbackConfig(true, true, false);
+
+  int16_t pinLength = getPinBlockLength();
+  int16_t stepSize = 0;
+  while ((1 << stepSize) < activePins) stepSize++;
+
+  for (int16_t i = 0; i < activePins; i++) {
+    splitDesc[i].setDefault();
+    splitDesc[i]
+      .setAction(i == activePins - 1 ? ACTION_BLOCK_INTERRUPT : ACTION_NONE)
+      .setDataSize(ADC_DBVAL_SIZE)
+      .setIncrementConfig(true, true)
+      .setTransferAmount(pinLength)
+      .setIncrementModifier(SOURCE, stepSize)
+      .setDestination((uint32_t)(splitDB + i * pinLength), true)
+      .setSource((uint32_t)(DB + i), true);
+  }
+  splitHalf = -1;
+  splitDrops = 0;
+  return true;
+}
+
+// Called from the data channel ISR -> half was just filled & DMAC is on the other one
+bool ADCModule::startSplit(int16_t half) {
+  // Previous split still running -> drop this block rather than stall the ISR
+  if (splitChannel == nullptr || splitChannel->isBusy()) {
+    splitDrops++;
+    return false;
+  }
+  TransferDescriptor *descList[ADC_SPLIT_MAX_PINS];
+  uint16_t *block = DB + half * getBlockLength();
+
+  for (int16_t i = 0; i < activePins; i++) {
+    splitDesc[i].setSource((uint32_t)(block + i), true);
+    descList[i] = &splitDesc[i];
+  }
+  if (!splitChannel->setDescriptors(descList, activePins, false, false)
+  || !splitChannel->enable()) {
+    currentError = ERROR_ADC_DMA;
+    return false;
+  }
+  splitHalf = half;
+  return splitChannel->trigger();
+}
+
 bool ADCModule::enableExternalRef() {
   if (erChannel > 0) {
     if (erDAC->CTRLA.bit.ENABLE) {
@@ -689,4 +1232,170 @@ bool ADCModule::enableExternalRef() {
       while(erDAC->SYNCBUSY.bit.ENABLE);        // Sync
     }
   }
-}
\ No newline at end of file
+}
+
+bool ADCModule::initTimerTrigger() {
+  if (triggerTimer == -1) return true;
+
+  // Route timer overflow -> ADC start, conversions no longer restart on their own
+  triggerEvent = System.evnt.connect(System.tim.getEventGenerator(triggerTimer),
+    ADC_REF[adcNum].startUser);
+  if (triggerEvent == -1) {
+    currentError = ERROR_ADC_TRIGGER;
+    return false;
+  }
+  adc->DSEQCTRL.bit.AUTOSTART = 0;
+  adc->EVCTRL.reg |= ADC_EVCTRL_STARTEI;        // Enable protected -> ADC still disabled here
+  return true;
+}
+
+void ADCModule::exitTimerTrigger() {
+  if (triggerEvent == -1) return;
+
+  System.evnt.disconnect(triggerEvent);
+  triggerEvent = -1;
+  adc->EVCTRL.reg &= ~ADC_EVCTRL_STARTEI;
+  adc->DSEQCTRL.bit.AUTOSTART = 1;
+}
+
+void ADCModule::freeTimer() {
+  if (!ownsTimer) return;
+
+  System.tim.freeTimer(triggerTimer);
+  triggerTimer = -1;
+  ownsTimer = false;
+}
+
+bool ADCModule::initPair() {
+  if (!pairEnabled) return true;
+  ADCModule *master = modules[0];
+
+  // ADC0 must still be idle so both start on the same trigger
+  if (master == nullptr || master->currentState != 1
+  || (pairInterleaved && (!streamEnabled || !master->streamEnabled || splitEnabled
+    || master->splitEnabled || master->DBLength != DBLength))) {
+    currentError = ERROR_ADC_PAIR;
+    return false;
+  }
+  adc->DSEQCTRL.bit.AUTOSTART = 0;              // Starts come from ADC0 only
+  adc->CTRLA.bit.SLAVEEN = 1;                   // Enable protected -> ADC still disabled here
+  return true;
+}
+
+void ADCModule::exitPair() {
+  if (!pairEnabled) return;
+
+  adc->CTRLA.bit.SLAVEEN = 0;
+  adc->DSEQCTRL.bit.AUTOSTART = 1;
+}
+
+// STEPSIZE of the stream destination -> X2 when the results of both modules are interleaved
+int16_t ADCModule::getStreamStride() {
+  if (pairInterleaved) return 1;
+  ADCModule *slave = modules[1];
+  if (adcNum == 0 && slave != nullptr && slave->pairInterleaved && slave->currentState == 2) {
+    return 1;
+  }
+  return 0;
+}
+
+bool ADCModule::initBuffer(uint16_t *buffer, uint32_t sampleCount) {
+  if (buffer == nullptr || sampleCount < ADC_STREAM_DESC_COUNT 
+  || sampleCount % ADC_STREAM_DESC_COUNT != 0 || sampleCount > ADC_MAX_DB_LENGTH) {
+    currentError = ERROR_ADC_SYS;
+    return false;
+  }
+  uint16_t *oldDB = DB;
+  uint32_t oldLength = DBLength;
+  uint16_t oldTransferSize = dataTransferSize;
+
+  DB = buffer;
+  DBLength = sampleCount;
+  dataTransferSize = MIN(dataTransferSize, (uint16_t)MIN(DBLength, (uint32_t)UINT16_MAX));
+
+  // Single shot descriptor points @ the buffer -> rebuild & reload, old buffer back if that fails
+  // (caller may free the new one, so it must not stay live)
+  if (!setDescDefault() || !ADCLoadBuffer(*dataChannel, dataDesc, DB, dataTransferSize)) {
+    DB = oldDB;
+    DBLength = oldLength;
+    dataTransferSize = oldTransferSize;
+    setDescDefault();
+    ADCLoadBuffer(*dataChannel, dataDesc, DB, dataTransferSize);
+    currentError = ERROR_ADC_DMA;
+    return false;
+  }
+  DBIndex = 0;
+  if (oldDB != buffer) arenaFree(oldDB);
+
+  // Split arrays are sized by the block -> carved again on the next enable
+  arenaFree(splitDB);
+  splitDB = nullptr;
+  return true;
+}
+
+bool ADCModule::initCapture() {
+  uint32_t segment = DBLength / ADC_CAPTURE_DESC_COUNT;
+  if (streamEnabled || pairInterleaved || adc->CTRLB.bit.WINMODE == WINDOW_MODE_DISABLE
+  || DBLength % ADC_CAPTURE_DESC_COUNT != 0 
+  || capturePre + capturePost + 2 * segment + ADC_CAPTURE_MARGIN > DBLength) {
+    currentError = ERROR_ADC_SYS;
+    return false;
+  }
+  TransferDescriptor *descList[ADC_CAPTURE_DESC_COUNT];
+
+  // No interrupts while armed -> DMAC just laps the ring
+  for (int16_t i = 0; i < ADC_CAPTURE_DESC_COUNT; i++) {
+    captureDesc[i]
+      .setAction(ACTION_NONE)
+      .setDataSize(ADC_DBVAL_SIZE)
+      .setIncrementConfig(false, true)
+      .setTransferAmount(segment)
+      .setDestination((uint32_t)(DB + i * segment), true)
+      .setSource((uint32_t)&adc->RESULT.reg, false);
+    descList[i] = &captureDesc[i];
+  }
+  if (!dataChannel->setDescriptors(descList, ADC_CAPTURE_DESC_COUNT, false, false)) {
+    currentError = ERROR_ADC_DMA;
+    return false;
+  }
+  dataChannel->settings
+    .setDescriptorsLooped(true, true)
+    .setCallbackConfig(true, true, false);
+
+  memset(DB, 0, DBLength * ADC_DBVAL_SIZE);
+  triggerIndex = 0;
+  stopSegment = -1;
+  captureState = CAPTURE_ARMED;
+
+  // Window -> WINMON interrupt (shares the first vector w overrun)
+  adc->INTFLAG.reg = ADC_INTFLAG_WINMON;
+  adc->INTENSET.reg = ADC_INTENSET_WINMON;
+  NVIC_ClearPendingIRQ(ADC_REF[adcNum].baseIRQ);
+  NVIC_EnableIRQ(ADC_REF[adcNum].baseIRQ);
+  return true;
+}
+
+void ADCModule::exitCapture() {
+  if (captureState == CAPTURE_IDLE) return;
+
+  adc->INTENCLR.reg = ADC_INTENCLR_WINMON;
+  NVIC_DisableIRQ(ADC_REF[adcNum].baseIRQ);
+  if (stopSegment != -1) dataChannel->setDescriptorAction(stopSegment, ACTION_NONE);
+  stopSegment = -1;
+  captureState = CAPTURE_IDLE;
+}
+
+// WINMON -> locate the DMAC in the ring & mark the segment holding the last post sample to
+// suspend the channel (ADCFindCaptureStop). Runs once per arm, everything after is the DMAC's.
+void ADCModule::triggerCapture() {
+  ADCCaptureStop stop;
+  if (!ADCFindCaptureStop(dataChannel->getActiveIndex(),
+    dataChannel->remainingBytes() / ADC_DBVAL_SIZE, DBLength, capturePost, stop)) {
+    return;
+  }
+  triggerIndex = stop.triggerIndex;
+  stopSegment = stop.stopSegment;
+  dataChannel->setDescriptorAction(stopSegment, ACTION_SUSPEND);
+  adc->INTENCLR.reg = ADC_INTENCLR_WINMON;
+  captureState = CAPTURE_TRIGGERED;
+}
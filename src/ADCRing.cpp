@@ -0,0 +1,104 @@
+#include <ADCRing.h>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> STREAM BLOCK QUEUE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+ADCBlockQueue::ADCBlockQueue() {
+  reset(nullptr, 0);
+}
+
+// Only valid while the stream channel is stopped
+void ADCBlockQueue::reset(uint16_t *buffer, int16_t blockLength) {
+  blocks.clear();
+  this->buffer = buffer;
+  this->blockLength = blockLength;
+  cursor = 0;
+  readOffset = 0;
+  overruns = 0;
+}
+
+// Next block the DMAC finished -> queued for the reader & returned, -1 once caught up (call
+// until -1). The DMAC is filling the block after it, so if the reader is still on that one (all
+// other blocks queued) it is being overwritten -> block is not queued, counted as overrun.
+// Note -> the block the reader holds is corrupt once an overrun is counted
+int16_t ADCBlockQueue::collect(TransferChannel &source) {
+  int16_t block = source.nextCompleted(cursor);
+  if (block == -1) return -1;
+
+  if (blocks.available() >= ADC_STREAM_DESC_COUNT - 1) {
+    overruns += blockLength;
+  } else {
+    blocks.write(&block, 1);
+  }
+  return block;
+}
+
+uint32_t ADCBlockQueue::samplesAvailable() {
+  uint32_t count = blocks.available();
+  return count ? count * blockLength - readOffset : 0;
+}
+
+// Returns a view of the oldest samples (up to the end of their block) -> call commitSamples()
+// when done
+uint32_t ADCBlockQueue::peekSamples(uint16_t *&samples) {
+  int16_t *block;
+  if (blocks.peekContiguous(block) == 0) {
+    samples = nullptr;
+    return 0;
+  }
+  samples = buffer + *block * blockLength + readOffset;
+  return blockLength - readOffset;
+}
+
+void ADCBlockQueue::commitSamples(uint32_t sampleCount) {
+  while (sampleCount > 0 && blocks.available() > 0) {
+    uint32_t count = MIN(sampleCount, blockLength - readOffset);
+    readOffset += count;
+    sampleCount -= count;
+    if (readOffset == (uint32_t)blockLength) {
+      readOffset = 0;
+      blocks.commit(1);
+    }
+  }
+}
+
+uint32_t ADCBlockQueue::getOverruns() { return overruns; }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> CAPTURE STOP
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// From the writeback as the window ISR reads it -> active segment & samples it has left. The
+// result that fired the window is already moved (DMA beats the ISR), so it is the last written.
+// False if the channel had no active segment.
+bool ADCFindCaptureStop(int16_t activeSegment, uint32_t remaining, uint32_t length,
+  uint32_t postSamples, ADCCaptureStop &stop) {
+  if (activeSegment < 0 || activeSegment >= ADC_CAPTURE_DESC_COUNT) return false;
+
+  uint32_t segment = length / ADC_CAPTURE_DESC_COUNT;
+  uint32_t written = activeSegment * segment + (segment - remaining);
+  stop.triggerIndex = (written + length - 1) % length;
+
+  // Active segment is already fetched & the next one may be any moment -> stop after them
+  int32_t last = (int32_t)written - 1 + postSamples - 1;
+  int32_t segmentIndex = MAX(last / (int32_t)segment, (int32_t)activeSegment + 1);
+  if (segmentIndex == activeSegment + 1 && remaining > 0 && remaining < ADC_CAPTURE_MARGIN) {
+    segmentIndex++;
+  }
+  stop.stopSegment = segmentIndex % ADC_CAPTURE_DESC_COUNT;
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> SINGLE SHOT BUFFER
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ADCLoadBuffer(TransferChannel &channel, TransferDescriptor &desc, uint16_t *buffer,
+  uint16_t transferSize) {
+  if (buffer == nullptr || transferSize == 0) return false;
+  desc
+    .setTransferAmount(transferSize)
+    .setDestination((uint32_t)buffer, true);
+  return desc.isValid() && channel.setDescriptor(&desc, false);
+}
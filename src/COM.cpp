@@ -3,6 +3,10 @@
 
 COM_ &COM;
 
+bool COMEnqueue(const COMSendEntry *entries, int16_t count) {
+  return COM.enqueue(entries, count);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> COM INTERRUPT HANDLER
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -13,20 +17,29 @@ void COMHandler(void) {
 
   uint8_t interruptReason = COM_REASON_UNKNOWN;        
   bool callbackValid = true;
-  bool readyRecv = false;  
   bool readySend = false;   
 
   // Interrupt on out endpoint
   if (USB->DEVICE.EPINTSMRY.reg & (1 << COM_EP_OUT)) {
-    readySend = true;
 
-    // Transfer complete flag
+    // Transfer complete flag -> re-arm with the next span (if queued), then release entries
     if (USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTFLAG.bit.TRCPT1) {
+      USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTFLAG.reg = USB_DEVICE_EPINTFLAG_TRCPT1;
       interruptReason = COM_REASON_SEND_COMPLETE;
 
+      COM.sendQueue.complete();
+      COM.armNext();
+
+      // Hand buffers back to their owners -> owner may enqueue again from inside the callback
+      COMSendEntry done;
+      while (COM.sendQueue.release(done)) {
+        if (done.releaseCB != nullptr) done.releaseCB(done.source);
+      }
+
     // Transfer fail flag
     } else if (USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTFLAG.bit.TRFAIL1) {
-      USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTFLAG.bit.TRFAIL1 = 1;
+      USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTFLAG.reg = USB_DEVICE_EPINTFLAG_TRFAIL1;
+      readySend = true;
       COM.currentError = ERROR_COM_SEND;
       interruptReason = COM_REASON_SEND_FAIL;
 
@@ -38,31 +51,27 @@ void COMHandler(void) {
     }
   // Interrupt on in endpoint
   } else if (USB->DEVICE.EPINTSMRY.reg & (1 << COM_EP_IN)) {
-    readyRecv = true;
 
-    // Transfer recieved flag -> shift recieve addr & req next packet
+    // Transfer recieved flag -> commit slot & re-arm bank on next free slot
     if (USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.bit.TRCPT0) {
+      USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.reg = USB_DEVICE_EPINTFLAG_TRCPT0;
       interruptReason = COM_REASON_RECEIVE_READY;
+      COM.commitRX();
 
-    // Transfer recieve fail flag
+    // Transfer recieve fail flag -> drop packet & re-arm same slot
     } else if (USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.bit.TRFAIL0) {
-      USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.bit.TRFAIL0 = 1;
+      USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.reg = USB_DEVICE_EPINTFLAG_TRFAIL0;
       COM.currentError = ERROR_COM_RECEIVE;
       interruptReason = COM_REASON_RECEIVE_FAIL;
   
       // Transfer fail due to buffer overflow?
-      if (COM.endp[COM_EP_IN]->DeviceDescBank->STATUS_BK.bit.ERRORFLOW == 1) { // MAYBE ADD A COM.FLUSH(0) HERE????
+      if (COM.endp[COM_EP_IN]->DeviceDescBank->STATUS_BK.bit.ERRORFLOW == 1) {
+        COM.endp[COM_EP_IN]->DeviceDescBank->STATUS_BK.bit.ERRORFLOW = 0;
         COM.currentError = ERROR_COM_MEM;
       }
+      COM.armRX();
     }
 
-    if (COM.rxiActive) {
-      uint16_t num = UDIV_CEIL(COM.endp[COM_EP_IN]->DeviceDescBank->
-        PCKSIZE.bit.BYTE_COUNT, COM_PACKET_SIZE); 
-      COM.RXi = (COM.RXi + num <= COM_RX_PACKETS * COM_PACKET_SIZE) ? num : COM.RXi;
-    }
-    COM.rxiActive = true;
-
   // Start of frame flag (every roughly ~1ms)
   } else if (USB->DEVICE.INTFLAG.bit.SOF) {
     USB->DEVICE.INTFLAG.bit.SOF = 1;
@@ -81,11 +90,7 @@ void COMHandler(void) {
   if ((COM.cbrMask & (1 << interruptReason)) == 1) {
     (*COM.callback)(interruptReason);
   }
-  // Ready send/recieve after callback
-  if (readyRecv) {
-    USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPSTATUSSET.bit.BK0RDY = 1; // Set ready status
-    USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTENCLR.bit.TRCPT0 = 1;  // Disable recieve complete interrupt
-  }
+  // Ready send after callback
   if (readySend) {
     USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPSTATUSCLR.bit.BK1RDY = 1; // Clear ready status   
   }
@@ -118,6 +123,9 @@ bool COM_::begin(USBDeviceClass *usbp) {
     }
   }
   USB_SetHandler(&COMHandler);
+
+  // Start recieve ring -> host can send right away
+  request(nullptr, 0, false);
   return true;
 }
 
@@ -134,52 +142,68 @@ bool COM_::end() {
 }
 
 bool COM_::sendPackets(void *source, uint16_t numPackets) {
-  if (!begun) return false;
-  
-  sendTO.start(false);
-  if (numPackets <= 0) return false;
-  
-  // If sendBusy & timeout -> send ZLP
-  if (sendBusy()) {
+  return sendPackets(source, numPackets, nullptr);
+}
+
+bool COM_::sendPackets(void *source, uint16_t numPackets, COMSendCallback releaseCallback) {
+  if (!begun || numPackets <= 0) return false;
+  return enqueue(source, numPackets * COM_PACKET_SIZE, releaseCallback, true);
+}
+
+bool COM_::enqueue(void *source, uint16_t numBytes, COMSendCallback releaseCallback,
+  bool endTransfer) {
+  COMSendEntry entry = { source, numBytes, releaseCallback, endTransfer };
+  return enqueue(&entry, 1);
+}
+
+// All entries or none -> e.g. a frame's header, payload & trailer
+// Note -> entries that do not end a transfer must be a multiple of 4 bytes (packet gather)
+bool COM_::enqueue(const COMSendEntry *entries, int16_t count) {
+  if (!begun || entries == nullptr || count <= 0) return false;
+
+  // Handle source ptr & size -> USB DMA reads source directly (must be word aligned)
+  for (int16_t i = 0; i < count; i++) {
+    uint32_t sourceAddr = (uint32_t)entries[i].source;
+    if (entries[i].numBytes == 0 || entries[i].numBytes > COM_SEND_MAX_PACKETS * COM_PACKET_SIZE
+    || sourceAddr == 0 || sourceAddr % 4 != 0
+    || (!entries[i].endTransfer && entries[i].numBytes % 4 != 0)) {
+      currentError = ERROR_COM_REQ;
+      return false;
+    }
+  }
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // Queue full -> backpressure, if endpoint stalled past timeout -> abort
+  if (sendQueue.space() < count) {
+    if (!primask) __enable_irq();
+
     if (sendTO++ == 0) {
-      endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT = 0;
       currentError = ERROR_COM_TIMEOUT;
-      abort();
+      abortSend();
     }
     return false;
   }
-
-  // Handle source ptr & numPackets
-  uint32_t sourceAddr = (uint32_t)&source;
-  if (numPackets > COM_SEND_MAX_PACKETS || sourceAddr == 0) {
-    currentError = ERROR_COM_REQ;
-    return false;
+  for (int16_t i = 0; i < count; i++) {
+    sendQueue.push(entries[i]);
   }
+  // Endpoint idle -> arm now, otherwise ISR arms it on transfer complete
+  if (!sendQueue.isArmed()) armNext();
+  if (!primask) __enable_irq();
+  return true;
+}
 
-  // Re-init endpoint descriptor
-  endp[COM_EP_OUT]->DeviceDescBank->ADDR.bit.ADDR = sourceAddr;         // Set adress of data to send
-  endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT = 0;         // Reset byte count
-  endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.MULTI_PACKET_SIZE = 0;  // Reset packet size counter
-  
-  // Configure endpoint descriptor for send
-  endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.MULTI_PACKET_SIZE       // Set number of packets
-    = numPackets;
-  endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT              // Set number of bytes in a packet
-    = COM_PACKET_SIZE;
-  USB->DEVICE.DeviceEndpoint->EPINTFLAG.bit.TRCPT1 = 1;                 // Clear transfer complete flag
-  USB->DEVICE.DeviceEndpoint->EPSTATUSSET.bit.BK1RDY = 1;               // Set "ready" status
+int16_t COM_::queueSpace() {
+  return sendQueue.space();
+}
 
-  sendTO.start(true);
-  return true;                  
+int16_t COM_::queueCount() {
+  return sendQueue.count();
 }
 
 bool COM_::sendBusy() {
   if (!begun) return false;
-  if (!USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTFLAG.bit.TRCPT1
-  || USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPSTATUS.bit.BK1RDY) {
-    return true;
-  }
-  return false;
+  return sendQueue.busy();
 }
 
 int16_t COM_::packetsSent() {
@@ -196,141 +220,162 @@ int16_t COM_::packetsRemaining() {
 
 bool COM_::abortSend() {
   if (!sendBusy()) return true;
-  int16_t transferSize = endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT; // Get send total bytes
-  endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.MULTI_PACKET_SIZE = transferSize;  // Set total bytes = sent bytes
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // Stop endpoint & clear flags
+  USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTENCLR.reg = USB_DEVICE_EPINTENCLR_TRCPT1;
+  USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPSTATUSCLR.reg = USB_DEVICE_EPSTATUSCLR_BK1RDY;
+  USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTFLAG.reg = USB_DEVICE_EPINTFLAG_TRCPT1;
+
+  // Give every queued buffer back to its owner
+  sendQueue.abort();
+  COMSendEntry entry;
+  while (sendQueue.release(entry)) {
+    if (entry.releaseCB != nullptr) entry.releaseCB(entry.source);
+  }
+  if (!primask) __enable_irq();
   return true;
 } 
 
+int16_t COM_::readPacket(uint8_t *&packet) {
+  if (!begun) {
+    packet = nullptr;
+    return 0;
+  }
+  // View of oldest packet -> stays valid until released
+  return rxRing.read(packet);
+}
+
+bool COM_::releasePacket() {
+  if (!begun || !rxRing.release()) return false;
+
+  // Ring was full -> bank was left un-armed, arm it on the slot just freed
+  if (rxStalled) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    armRX();
+    if (!primask) __enable_irq();
+  }
+  return true;
+}
+
 int16_t COM_::recievePackets(void *destination, uint16_t numPackets, bool forceRecieve) {
   if (!begun) return -1;
-
   if (destination == nullptr) return -1;
-  if (USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.bit.TRCPT0 == 0 
-    && !forceRecieve) return 0;
-
-  if (available(true)) {
-    if (numPackets > available(true)) {
-      if (enforceNumPackets) return 0;
-      numPackets = available(true);
 
-    } else if (numPackets == 0) {
-      numPackets = COM_DEFAULT_RECIEVE;
-    }
-    // Transfer requested bytes from RX
-    uint16_t reqBytes = numPackets * COM_PACKET_SIZE;
-    memcpy(&destination, RX + (RXi - reqBytes), reqBytes);
-    RXi -= reqBytes;
+  // Determine packet count
+  uint16_t count = rxRing.available(true);
+  if (numPackets == 0) numPackets = COM_DEFAULT_RECIEVE;
+  if (numPackets > count) {
+    if (enforceNumPackets && !forceRecieve) return 0;
+    numPackets = count;
   }
-
-  if (RXi <= 0) {
-    resetSize(COM_EP_IN);
-    RXi = 0;
+  // Copy oldest packets first (in order recieved)
+  uint8_t *dest = (uint8_t*)destination;
+  uint8_t *packet;
+  for (uint16_t i = 0; i < numPackets; i++) {
+    int16_t length = readPacket(packet);
+    memcpy(dest, packet, length);
+    dest += length;
+    releasePacket();
   }
-  return true;
+  return numPackets;
 }
 
 bool COM_::request(void *customDest, uint16_t numPackets, bool forceReq) {
   if (!begun) return false;
 
+  // No custom destination -> (re)start recieve ring
+  if (customDest == nullptr) {
+    if (rxArmed && rxCustom == nullptr) return true;
+    if (rxCustom != nullptr) {
+      if (forceReq) cancelRequest();
+      else return false;
+    }
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    rxArmed = true;
+    armRX();
+    if (!primask) __enable_irq();
+    return true;
+  }
   // Handle exceptions
-  if (RXi > COM_RX_PACKETS - 1) {
+  if ((uint32_t)customDest % 4 != 0) {
     currentError = ERROR_COM_REQ;
     return false;
   }
-  if (requestPending()) {
+  if (rxCustom != nullptr) {
     if (forceReq) cancelRequest();
     else return false;
   }
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
 
-  // Determine packet count for recieve
-  uint16_t bytes = (!numPackets ? COM_DEFAULT_REQ : numPackets) * COM_PACKET_SIZE;
-
-  if (customDest == nullptr && numPackets != 0 
-  && RXi + numPackets > COM_RX_PACKETS) {
-    if (enforceNumPackets) return false;
-    bytes = (COM_RX_PACKETS - RXi) * COM_PACKET_SIZE; 
-  }
-
-  resetSize(COM_EP_IN); // Must reset sizes to initiate enable recieve
+  // Stop ring -> one shot into custom dest, ring resumes once it completes
+  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPSTATUSSET.reg = USB_DEVICE_EPSTATUSSET_BK0RDY;
+  rxCustom = customDest;
+  rxCustomBytes = 0;
 
-  endp[COM_EP_IN]->DeviceDescBank->ADDR.bit.ADDR 
-    = (customDest == nullptr) ? (uint32_t)RX + bytes : (uint32_t)customDest; // Set destination
-  endp[COM_EP_IN]->DeviceDescBank->PCKSIZE.bit.MULTI_PACKET_SIZE = bytes;    // Set packet count
-      
-  // Enable recieve
-  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPSTATUSCLR.bit.BK0RDY = 1; // Clear ready status
-  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.bit.TRCPT0 = 1;   // Clear recieved flag
-  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTENSET.bit.TRCPT0 = 1;  // Enable transfer complete interrupt
-
-  rxiLast = RXi;
+  uint16_t bytes = (!numPackets ? COM_DEFAULT_REQ : numPackets) * COM_PACKET_SIZE;
+  armBank(customDest, bytes);
+  if (!primask) __enable_irq();
   return true;
 }
 
 bool COM_::flush(int16_t numPackets) {
   if (!begun) return false;
-
-  CLAMP(numPackets, -available(true), available(true));
-  uint16_t reqBytes = abs(numPackets) * COM_PACKET_SIZE;
-  uint16_t absBytes = available(false);
-
-  if (abs(numPackets) == available(true)) { // Clear entire RX buffer
-      memset(RX, 0, sizeof(RX));
-      RXi = 0;
-
-  } else if (numPackets == 0) { // Clear most packets in RX buffer that wer last recieved
-    if (rxiLast != RXi) { 
-      memset(RX + rxiLast, 0, (COM_RX_PACKETS - rxiLast) * COM_PACKET_SIZE);
-    } else {
-      memset(RX + RXi, 0, (COM_RX_PACKETS - RXi) * COM_PACKET_SIZE);
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // Drop oldest (+) or newest (-) packets, 0 -> the last one received. Clamped to what is held,
+  // empty ring -> nothing dropped.
+  // Note -> whole ring is flush(available(true))
+  if (numPackets == 0) numPackets = -1;
+  if (rxRing.flush(numPackets) < 0) {
+
+    // Bank sits on the old head slot -> stop it, re-armed on the new head below
+    if (rxArmed && !rxStalled && rxCustom == nullptr) {
+      USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPSTATUSSET.reg = USB_DEVICE_EPSTATUSSET_BK0RDY;
+      rxStalled = true;
     }
-    RXi = rxiLast;
-
-  } else { // Else -> removing packets from top or bottom of RX buffer
-    if (numPackets < 0) {
-      memmove(RX + reqBytes, RX, absBytes - reqBytes);
-    }
-    memset(RX + (absBytes - reqBytes), 0, reqBytes);
-    RXi -= abs(numPackets);
-  } 
+  }
+  if (rxStalled) armRX();
+  if (!primask) __enable_irq();
   return true;
 }
 
 int16_t COM_::packetsRecieved() { 
   if (!begun) return -1;
+  if (rxCustom == nullptr) return 0;
   uint16_t n = UDIV_CEIL(endp[COM_EP_IN]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT,
     COM_PACKET_SIZE);
-  return (requestPending() ? n : 0);
+  return n;
 }
 
 void COM_::cancelRequest() {
   if (!begun) return;
-  // Dissable interrupts
-  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTENCLR.bit.TRCPT0 = 1;
-  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTENCLR.bit.TRFAIL0 = 1;
-
-  // Record current count & reset it.
-  uint16_t count = endp[COM_EP_IN]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT;
-  endp[COM_EP_IN]->DeviceDescBank->PCKSIZE.bit.MULTI_PACKET_SIZE = count;
-
-  // Set ready status -> stops transfer
-  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPSTATUSSET.bit.BK0RDY = 1; 
-
-  // Set recieve buffer (RX) index
-  RXi += count;
-  if (RXi >= COM_RX_PACKETS) {
-    RXi = COM_RX_PACKETS - 1;
-    currentError = ERROR_COM_RECEIVE;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // Disable interrupts & set ready status -> stops transfer (host gets NAK)
+  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTENCLR.reg = USB_DEVICE_EPINTENCLR_TRCPT0
+    | USB_DEVICE_EPINTENCLR_TRFAIL0;
+  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPSTATUSSET.reg = USB_DEVICE_EPSTATUSSET_BK0RDY;
+
+  // Record bytes that made it into custom dest, partial ring slot is discarded
+  if (rxCustom != nullptr) {
+    rxCustomBytes = endp[COM_EP_IN]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT;
+    rxCustom = nullptr;
   }
-  // Re-enable interrupts
-  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTENCLR.bit.TRCPT0 = 1;
-  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTENCLR.bit.TRFAIL0 = 1;
-  rxiActive = true;
+  rxArmed = false;
+  rxStalled = false;
+  if (!primask) __enable_irq();
 }
 
 bool COM_::requestPending() {
   if (!begun) return false;
-  return (USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.bit.TRCPT0 == 0
-  || USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPSTATUS.bit.BK0RDY == 0);
+  return rxCustom != nullptr;
 }
 
 int32_t COM_::getFrameCount(bool getMicroFrameCount) { 
@@ -340,11 +385,7 @@ int32_t COM_::getFrameCount(bool getMicroFrameCount) {
 
 int16_t COM_::available(bool packets) {
   if (!begun) return -1;
-  uint16_t bytes = RXi * COM_PACKET_SIZE;
-  if (requestPending()) {
-    bytes += endp[COM_EP_IN]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT;
-  }
-  return (packets ? UDIV_CEIL(bytes, COM_PACKET_SIZE) : bytes);
+  return rxRing.available(packets);
 }
 
 int16_t COM_::getPeripheralState() { 
@@ -354,8 +395,14 @@ int16_t COM_::getPeripheralState() {
 
 uint8_t *COM_::inspectPacket(uint16_t packetIndex) {
   if (!begun) return nullptr; 
-  CLAMP(packetIndex, 0, RXi - 1);
-  return &RX[(RXi - 1) - packetIndex]; 
+
+  // Index 0 -> oldest packet, out of range -> newest
+  return rxRing.inspect(packetIndex);
+}
+
+int16_t COM_::customBytesRecieved() {
+  if (!begun) return -1;
+  return rxCustomBytes;
 }
 
 ERROR_ID COM_::getError() { 
@@ -379,14 +426,91 @@ COM_::COM_() : sendTO(COM_DEFAULT_TIMEOUT, false), otherTO(COM_DEFAULT_TIMEOUT,
 }
 
 void COM_::resetFields() {
-  memset(RX, 0, sizeof(RX));
   sendTO.setTimeout(COM_DEFAULT_TIMEOUT);
   otherTO.setTimeout(COM_DEFAULT_TIMEOUT);
-  RXi = 0;
-  rxiLast = 0;
-  rxiActive = true;
+  rxRing.reset();
+  rxArmed = false;
+  rxStalled = false;
+  rxCustom = nullptr;
+  rxCustomBytes = 0;
   currentError = ERROR_NONE;
   begun = false;
+  sendQueue.reset();
+}
+
+// Note -> call from ISR or with interrupts masked
+void COM_::armNext() {
+  COMSendSpan span;
+  if (!sendQueue.next(span)) return;
+
+  // Auto ZLP only if span ends a transfer on a packet boundary (else host keeps waiting)
+  bool zlp = autoZLP && span.endTransfer && (span.numBytes % COM_PACKET_SIZE == 0);
+
+  // Re-init endpoint descriptor
+  endp[COM_EP_OUT]->DeviceDescBank->ADDR.bit.ADDR = (uint32_t)span.address; // Set adress of data to send
+  endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.MULTI_PACKET_SIZE = 0;      // Reset sent byte counter
+  endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT                  // Set total number of bytes
+    = span.numBytes;
+  endp[COM_EP_OUT]->DeviceDescBank->PCKSIZE.bit.AUTO_ZLP = zlp;             // Terminate w ZLP (if needed)
+
+  USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTFLAG.reg                      // Clear transfer complete flag
+    = USB_DEVICE_EPINTFLAG_TRCPT1;
+  USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPINTENSET.reg                     // Enable transfer complete interrupt
+    = USB_DEVICE_EPINTENSET_TRCPT1;
+  USB->DEVICE.DeviceEndpoint[COM_EP_OUT].EPSTATUSSET.reg                    // Set "ready" status
+    = USB_DEVICE_EPSTATUSSET_BK1RDY;
+  sendTO.start(true);
+}
+
+// Note -> call from ISR or with interrupts masked
+void COM_::commitRX() {
+  uint16_t count = endp[COM_EP_IN]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT;
+
+  // One shot into custom dest done -> fall back to ring
+  if (rxCustom != nullptr) {
+    rxCustom = nullptr;
+    rxCustomBytes = count;
+  } else {
+    rxRing.commit(count);
+  }
+  armRX();
+}
+
+// Note -> call from ISR or with interrupts masked
+void COM_::armRX() {
+  if (rxCustom != nullptr || !rxArmed) return;
+
+  // Ring full -> leave bank "ready" (host gets NAK) until a packet is released
+  uint8_t *slot = rxRing.armSlot();
+  if (slot == nullptr) {
+    rxStalled = true;
+    return;
+  }
+  rxStalled = false;
+  armBank(slot, COM_PACKET_SIZE);
+}
+
+// Note -> call from ISR or with interrupts masked
+void COM_::armBank(void *destination, uint16_t numBytes) {
+  endp[COM_EP_IN]->DeviceDescBank->ADDR.bit.ADDR = (uint32_t)destination; // Set destination
+  endp[COM_EP_IN]->DeviceDescBank->PCKSIZE.bit.MULTI_PACKET_SIZE = numBytes; // Set max bytes
+  endp[COM_EP_IN]->DeviceDescBank->PCKSIZE.bit.BYTE_COUNT = 0;            // Reset recieved byte counter
+
+  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.reg                     // Clear recieved flags
+    = USB_DEVICE_EPINTFLAG_TRCPT0 | USB_DEVICE_EPINTFLAG_TRFAIL0;
+  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTENSET.reg                    // Enable recieve interrupts
+    = USB_DEVICE_EPINTENSET_TRCPT0 | USB_DEVICE_EPINTENSET_TRFAIL0;
+  USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPSTATUSCLR.reg                   // Clear ready status -> accept data
+    = USB_DEVICE_EPSTATUSCLR_BK0RDY;
+}
+
+void COM_::initEP() {
+  // Control request may have re-initialized the endpoint -> re-arm ring if bank no longer accepts data
+  if (!rxArmed || rxStalled || rxCustom != nullptr) return;
+  if (USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPSTATUS.bit.BK0RDY
+  && !USB->DEVICE.DeviceEndpoint[COM_EP_IN].EPINTFLAG.bit.TRCPT0) {
+    armRX();
+  }
 }
 
 void COM_::resetSize(int16_t endpoint) {
@@ -435,6 +559,11 @@ COM_::COMSettings &COM_::COMSettings::setTimeout(uint32_t timeout) {
   return *this;
 }
 
+COM_::COMSettings &COM_::COMSettings::setAutoZLPConfig(bool enableAutoZLP) {
+  super->autoZLP = enableAutoZLP;
+  return *this;
+}
+
 COM_::COMSettings &COM_::COMSettings::setEnforceNumPacketConfig(bool enforceNumPackets) {
   super->enforceNumPackets = enforceNumPackets;
   return *this;
@@ -448,6 +577,7 @@ void COM_::COMSettings::setDefault() {
   super->STOtime = COM_DEFAULT_TIMEOUT;
   super->OTOtime = COM_DEFAULT_TIMEOUT;
   super->enforceNumPackets = COM_DEFAULT_ENFORCE_NUM;
+  super->autoZLP = COM_DEFAULT_AUTO_ZLP;
 }
 
 
@@ -0,0 +1,191 @@
+#include <COMQueue.h>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> COM SEND QUEUE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+COMSendQueue::COMSendQueue() {
+  reset();
+}
+
+// Returns false if full (backpressure)
+bool COMSendQueue::push(const COMSendEntry &entry) {
+  uint8_t nextHead = (head + 1) % COM_SEND_QUEUE_LENGTH;
+  if (nextHead == done) return false;
+  entries[head] = entry;
+  head = nextHead;
+  return true;
+}
+
+// Returns false if nothing to send, a span is still on the endpoint or the stage is waiting
+// for the rest of its packet
+bool COMSendQueue::next(COMSendSpan &span) {
+  if (armed) return false;
+
+  while (tail != head) {
+    COMSendEntry &entry = entries[tail];
+    const uint8_t *source = (const uint8_t*)entry.source + offset;
+    uint16_t remaining = entry.numBytes - offset;
+
+    // Packet already started in stage or entry would leave a short packet mid transfer
+    if (stageFill > 0 || (remaining < COM_PACKET_SIZE && !entry.endTransfer)) {
+      uint16_t count = MIN(remaining, COM_PACKET_SIZE - stageFill);
+      memcpy(stage + stageFill, source, count);
+      stageFill += count;
+      bool ends = handOut(count);
+      if (stageFill == COM_PACKET_SIZE || ends) return arm(span, stage, stageFill, ends);
+      continue;
+    }
+    // Whole packets in place, the rest goes through stage unless the transfer ends here
+    uint16_t count = entry.endTransfer ? remaining : remaining - remaining % COM_PACKET_SIZE;
+    bool ends = handOut(count);
+    return arm(span, source, count, ends);
+  }
+  return false;
+}
+
+// Endpoint is done w the span from next() -> entries it finished become releasable
+void COMSendQueue::complete() {
+  if (!armed) return;
+  ready = armedTail;
+  armed = false;
+  if (armedStage) stageFill = 0;
+}
+
+// Pops the oldest entry the endpoint is done with (call until false)
+bool COMSendQueue::release(COMSendEntry &entry) {
+  if (done == ready) return false;
+  entry = entries[done];
+  done = (done + 1) % COM_SEND_QUEUE_LENGTH;
+  return true;
+}
+
+// Everything queued becomes releasable -> caller must have stopped the endpoint first
+void COMSendQueue::abort() {
+  tail = head;
+  ready = head;
+  armed = false;
+  offset = 0;
+  stageFill = 0;
+}
+
+int16_t COMSendQueue::space() {
+  return (COM_SEND_QUEUE_LENGTH - 1) - count();
+}
+
+// Entries not yet released (incl. the one on the endpoint)
+int16_t COMSendQueue::count() {
+  return (head - done + COM_SEND_QUEUE_LENGTH) % COM_SEND_QUEUE_LENGTH;
+}
+
+bool COMSendQueue::busy() { return armed || tail != head || stageFill > 0; }
+
+bool COMSendQueue::isArmed() { return armed; }
+
+void COMSendQueue::reset() {
+  memset(entries, 0, sizeof(entries));
+  head = 0;
+  tail = 0;
+  done = 0;
+  ready = 0;
+  armed = false;
+  armedTail = 0;
+  offset = 0;
+  memset(stage, 0, sizeof(stage));
+  stageFill = 0;
+  armedStage = false;
+}
+
+// Moves past count bytes of the entry @ tail -> true if that ends its transfer
+bool COMSendQueue::handOut(uint16_t count) {
+  COMSendEntry &entry = entries[tail];
+  offset += count;
+  if (offset < entry.numBytes) return false;
+  offset = 0;
+  tail = (tail + 1) % COM_SEND_QUEUE_LENGTH;
+  return entry.endTransfer;
+}
+
+bool COMSendQueue::arm(COMSendSpan &span, const uint8_t *address, uint16_t numBytes,
+  bool endTransfer) {
+  span.address = address;
+  span.numBytes = numBytes;
+  span.endTransfer = endTransfer;
+  armedStage = (address == stage);
+  armedTail = tail;
+  armed = true;
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> COM RECEIVE RING
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+COMReceiveRing::COMReceiveRing() {
+  reset();
+}
+
+// Slot to arm the bank on -> nullptr if full (leave bank un-armed until a release)
+uint8_t *COMReceiveRing::armSlot() {
+  if ((uint8_t)(head - tail) >= COM_RX_PACKETS) return nullptr;
+  return data + (head % COM_RX_PACKETS) * COM_PACKET_SIZE;
+}
+
+// Bank filled the slot from armSlot()
+void COMReceiveRing::commit(uint16_t numBytes) {
+  lengths[head % COM_RX_PACKETS] = numBytes;
+  head++;
+}
+
+// View of the oldest packet (length returned) -> stays valid until released
+int16_t COMReceiveRing::read(uint8_t *&packet) {
+  if (head == tail) {
+    packet = nullptr;
+    return 0;
+  }
+  uint8_t slot = tail % COM_RX_PACKETS;
+  packet = data + slot * COM_PACKET_SIZE;
+  return lengths[slot];
+}
+
+bool COMReceiveRing::release() {
+  if (head == tail) return false;
+  tail++;
+  return true;
+}
+
+// Drops oldest (+) or newest (-) packets, clamped to what is held -> returns what was dropped
+// (same sign). Newest dropped -> head moved back, bank must be re-armed on the new head.
+int16_t COMReceiveRing::flush(int16_t numPackets) {
+  uint8_t count = head - tail;
+  numPackets = CLAMP(numPackets, -(int16_t)count, (int16_t)count);
+  if (numPackets > 0) tail += numPackets;
+  else head += numPackets;
+  return numPackets;
+}
+
+// Index 0 -> oldest packet, past the newest -> newest
+uint8_t *COMReceiveRing::inspect(uint16_t packetIndex) {
+  uint8_t count = head - tail;
+  if (count == 0) return nullptr;
+  packetIndex = CLAMP(packetIndex, 0, count - 1);
+  return data + ((uint8_t)(tail + packetIndex) % COM_RX_PACKETS) * COM_PACKET_SIZE;
+}
+
+int16_t COMReceiveRing::available(bool packets) {
+  uint8_t newest = head;
+  if (packets) return (uint8_t)(newest - tail);
+
+  int16_t bytes = 0;
+  for (uint8_t i = tail; i != newest; i++) {
+    bytes += lengths[i % COM_RX_PACKETS];
+  }
+  return bytes;
+}
+
+void COMReceiveRing::reset() {
+  memset(data, 0, sizeof(data));
+  memset(lengths, 0, sizeof(lengths));
+  head = 0;
+  tail = 0;
+}
@@ -1,2 +1,406 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> DAC
+///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <DAC.h>
+
+static const uint8_t DAC_PINS[BOARD_DAC_CHANNEL_COUNT] = { PIN_DAC0, PIN_DAC1 };
+static DACModule *modules[BOARD_DAC_CHANNEL_COUNT] = { nullptr, nullptr };
+
+// Note -> both channels share CTRLA/CTRLB & config is enable protected, so track who is using it
+static uint8_t channelsBegun = 0;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DAC INTERRUPT
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DACDMACallback(DMA_CALLBACK_REASON reason, TransferChannel &source,
+  int16_t descriptorIndex) {
+
+  if (reason == REASON_TRANSFER_COMPLETE_SUSPENDED
+   || reason == REASON_TRANSFER_COMPLETE_STOPPED) {
+
+    for (int16_t i = 0; i < BOARD_DAC_CHANNEL_COUNT; i++) {
+      DACModule *targ = modules[i];
+      if (targ != nullptr && targ->channelNumber == source.getOwnerID()
+        && targ->mode == DAC_MODE_STREAM) {
+
+        // Every block the DMAC finished playing since the last pass is free to refill (from the
+        // writeback -> a late ISR covering 2 blocks still refills both)
+        int16_t blockLength = targ->getBlockLength();
+        int16_t half;
+        while ((half = source.nextCompleted(targ->nextBlock)) != -1) {
+          targ->blockCount++;
+          if (targ->refillCB != nullptr) {
+            targ->refillCB(*targ, targ->streamBuffer + half * blockLength, blockLength, half);
+          }
+        }
+      }
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DAC MODULE CLASS (PUBLIC METHODS)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+DACModule::DACModule(uint8_t channelNum)
+  : channelNumber(MIN(channelNum, BOARD_DAC_CHANNEL_COUNT - 1)) {
+
+  dac = DAC;
+  channel = nullptr;
+  timer = -1;
+  resetFields();
+  settings.setDefault();
+}
+
+bool DACModule::begin() {
+  if (currentState) return true;
+  if (modules[channelNumber] != nullptr) return false;
+
+  // Pacing timer -> one DMA beat (sample) per overflow
+  timer = System.tim.allocTimer();
+  if (timer == -1) {
+    currentError = ERROR_DAC_TIMER;
+    return false;
+  }
+  if (!initDMA() || !initDAC()) {
+    exitDMA();
+    System.tim.freeTimer(timer);
+    timer = -1;
+    return false;
+  }
+  System.tim.setRate(timer, sampleRate);
+
+  modules[channelNumber] = this;
+  currentState = 1;
+  return true;
+}
+
+void DACModule::end() {
+  if (currentState == 0) return;
+  stop();
+
+  exitDAC();
+  exitDMA();
+  System.tim.freeTimer(timer);
+  timer = -1;
+
+  modules[channelNumber] = nullptr;
+  resetFields();
+  settings.setDefault();
+}
+
+bool DACModule::setWaveform(const uint16_t *samples, uint16_t sampleCount) {
+  if (currentState != 1 || samples == nullptr || sampleCount == 0) {
+    currentError = ERROR_DAC_SYS;
+    return false;
+  }
+  // One block looped onto itself -> plays forever w/out interrupts
+  desc[0]
+    .setAction(ACTION_NONE)
+    .setDataSize(sizeof(uint16_t))
+    .setIncrementConfig(true, false)
+    .setTransferAmount(sampleCount)
+    .setSource((uint32_t)samples, true)
+    .setDestination((uint32_t)&dac->DATA[channelNumber].reg, false);
+
+  TransferDescriptor *descList[] = { &desc[0] };
+  if (!channel->setDescriptors(descList, 1, false, false)) {
+    currentError = ERROR_DAC_DMA;
+    return false;
+  }
+  channel->settings
+    .setDescriptorsLooped(true, true)
+    .setCallbackConfig(true, false, false);
+
+  waveform = samples;
+  streamBuffer = nullptr;
+  bufferLength = sampleCount;
+  refillCB = nullptr;
+  mode = DAC_MODE_WAVEFORM;
+  return true;
+}
+
+bool DACModule::setStream(uint16_t *buffer, uint32_t sampleCount, DACRefillCallback callback) {
+  if (currentState != 1 || buffer == nullptr || sampleCount < DAC_STREAM_DESC_COUNT
+    || sampleCount % DAC_STREAM_DESC_COUNT != 0
+    || sampleCount / DAC_STREAM_DESC_COUNT > DAC_MAX_WAVEFORM_LENGTH) {
+    currentError = ERROR_DAC_SYS;
+    return false;
+  }
+  uint16_t blockLength = sampleCount / DAC_STREAM_DESC_COUNT;
+  TransferDescriptor *descList[DAC_STREAM_DESC_COUNT];
+
+  // Equal halves -> each raises an interrupt once played (channel keeps going)
+  for (int16_t i = 0; i < DAC_STREAM_DESC_COUNT; i++) {
+    desc[i]
+      .setAction(ACTION_BLOCK_INTERRUPT)
+      .setDataSize(sizeof(uint16_t))
+      .setIncrementConfig(true, false)
+      .setTransferAmount(blockLength)
+      .setSource((uint32_t)(buffer + i * blockLength), true)
+      .setDestination((uint32_t)&dac->DATA[channelNumber].reg, false);
+    descList[i] = &desc[i];
+  }
+  if (!channel->setDescriptors(descList, DAC_STREAM_DESC_COUNT, false, false)) {
+    currentError = ERROR_DAC_DMA;
+    return false;
+  }
+  channel->settings
+    .setDescriptorsLooped(true, true)
+    .setCallbackConfig(true, true, false);
+
+  waveform = nullptr;
+  streamBuffer = buffer;
+  bufferLength = sampleCount;
+  refillCB = callback;
+  mode = DAC_MODE_STREAM;
+  return true;
+}
+
+bool DACModule::start() {
+  if (currentState == 2) return true;
+  if (currentState != 1 || mode == DAC_MODE_NONE) {
+    currentError = ERROR_DAC_SYS;
+    return false;
+  }
+  blockCount = 0;
+  nextBlock = 0;
+
+  // Channel armed first -> first overflow moves the first sample
+  channel->setAllValid(true);
+  if (!channel->enable() || !channel->enableExternalTrigger()) {
+    currentError = ERROR_DAC_DMA;
+    return false;
+  }
+  if (!System.tim.start(timer)) {
+    channel->disable(false);
+    currentError = ERROR_DAC_TIMER;
+    return false;
+  }
+  currentState = 2;
+  return true;
+}
+
+void DACModule::stop() {
+  if (currentState != 2) return;
+
+  System.tim.stop(timer);
+  channel->disable(false);
+  currentState = 1;
+}
+
+// Stimulus/response -> ADC conversions started by the same overflow that moves each DAC sample.
+// ADC is armed before the timer runs, so the phase is fixed, but the conversion samples while
+// the DAC still holds the previous value -> capture sample k sees stimulus k - DAC_CAPTURE_LAG
+// (sample 0 sees the level from before start). Drop the first DAC_CAPTURE_LAG capture samples
+// to line them up.
+// Note -> capture must be begun but not enabled, see ADCSettings::setTimerTrigger for limits
+bool DACModule::startCapture(ADCModule &capture) {
+  if (currentState != 1 || mode == DAC_MODE_NONE) {
+    currentError = ERROR_DAC_SYS;
+    return false;
+  }
+  capture.settings.setTimerTrigger(timer);
+  if (!capture.enable()) {
+    capture.settings.setTimerTrigger(-1);
+    currentError = ERROR_DAC_SYS;
+    return false;
+  }
+  if (!start()) {
+    capture.disable();
+    capture.settings.setTimerTrigger(-1);
+    return false;
+  }
+  return true;
+}
+
+void DACModule::stopCapture(ADCModule &capture) {
+  stop();
+  capture.disable();
+  capture.settings.setTimerTrigger(-1);
+}
+
+bool DACModule::isRunning() { return currentState == 2; }
+
+bool DACModule::write(uint16_t value) {
+  if (currentState != 1) return false;
+
+  dac->DATA[channelNumber].reg = MIN(value, DAC_MAX_VALUE);
+  while(dac->SYNCBUSY.reg & (DAC_SYNCBUSY_DATA0 << channelNumber));
+  return true;
+}
+
+float DACModule::getSampleRate() {
+  return (timer == -1) ? 0 : System.tim.getRate(timer);
+}
+
+uint16_t *DACModule::getBlock(int16_t blockIndex) {
+  if (mode != DAC_MODE_STREAM || blockIndex < 0 || blockIndex >= DAC_STREAM_DESC_COUNT) {
+    return nullptr;
+  }
+  return streamBuffer + blockIndex * getBlockLength();
+}
+
+int16_t DACModule::getBlockLength() { return bufferLength / DAC_STREAM_DESC_COUNT; }
+
+uint32_t DACModule::getBlockCount() { return blockCount; }
+
+int16_t DACModule::getTimer() { return timer; }
+
+ERROR_ID DACModule::getError() { return currentError; }
+
+DACModule::~DACModule() { end(); }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DAC MODULE SETTINGS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+DACModule::DACSettings::DACSettings(DACModule *super) : super(super) {}
+
+// Note -> actual rate is the timer's (integer period), read it back w/ getSampleRate()
+DACModule::DACSettings &DACModule::DACSettings::setSampleRate(float hz) {
+  super->sampleRate = CLAMP(hz, 1.0f, (float)DAC_MAX_SAMPLE_RATE);
+  if (super->currentState != 0) {
+    System.tim.setRate(super->timer, super->sampleRate);
+  }
+  return *this;
+}
+
+// Note -> reference is shared by both channels, applied on the next begin()
+DACModule::DACSettings &DACModule::DACSettings::setReference(DAC_REFERENCE reference) {
+  if (super->currentState == 0) {
+    super->reference = reference;
+  }
+  return *this;
+}
+
+DACModule::DACSettings &DACModule::DACSettings::setDitherConfig(bool enableDither) {
+  if (super->currentState == 0) {
+    super->dither = enableDither;
+  }
+  return *this;
+}
+
+DACModule::DACSettings &DACModule::DACSettings::setStandbyConfig(bool runWhileStandby) {
+  if (super->currentState == 0) {
+    super->runStandby = runWhileStandby;
+  }
+  return *this;
+}
+
+DACModule::DACSettings &DACModule::DACSettings::
+  setPriorityClass(DMA_PRIORITY_CLASS priorityClass) {
+  if (super->currentState == 0) {
+    super->priorityClass = priorityClass;
+  }
+  return *this;
+}
+
+void DACModule::DACSettings::setDefault() {
+  super->sampleRate = DAC_DEFAULT_SAMPLE_RATE;
+  super->reference = DAC_DEFAULT_REFERENCE;
+  super->dither = DAC_DEFAULT_DITHER;
+  super->runStandby = DAC_DEFAULT_RUN_STANDBY;
+  super->priorityClass = DAC_DEFAULT_PRIORITY_CLASS;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DAC MODULE CLASS (PRIVATE METHODS)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DACModule::resetFields() {
+  currentState = 0;
+  blockCount = 0;
+  nextBlock = 0;
+  mode = DAC_MODE_NONE;
+  waveform = nullptr;
+  streamBuffer = nullptr;
+  bufferLength = 0;
+  refillCB = nullptr;
+  currentError = ERROR_NONE;
+}
+
+bool DACModule::initDAC() {
+  const PinDescription &pin = g_APinDescription[DAC_PINS[channelNumber]];
+
+  // First channel up -> clock & reset the peripheral
+  if (channelsBegun == 0) {
+    MCLK->APBDMASK.reg |= MCLK_APBDMASK_DAC;
+    GCLK->PCHCTRL[DAC_GCLK_ID].reg = DAC_GCLK_GENERATOR | GCLK_PCHCTRL_CHEN;
+    while(!(GCLK->PCHCTRL[DAC_GCLK_ID].reg & GCLK_PCHCTRL_CHEN));
+
+    dac->CTRLA.bit.SWRST = 1;
+    while(dac->SYNCBUSY.bit.SWRST);
+  }
+
+  // Note -> CTRLB & DACCTRL are enable protected, the other channel glitches while we reconfigure
+  dac->CTRLA.bit.ENABLE = 0;
+  while(dac->SYNCBUSY.bit.ENABLE);
+
+  dac->CTRLB.bit.REFSEL = reference;
+  dac->DACCTRL[channelNumber].reg
+    = DAC_DACCTRL_ENABLE
+    | DAC_DACCTRL_CCTRL_CC12M
+    | (dither ? DAC_DACCTRL_DITHER : 0)
+    | (runStandby ? DAC_DACCTRL_RUNSTDBY : 0);
+
+  // Configure pin w multiplexer/port module
+  PORT->Group[pin.ulPort].PMUX[pin.ulPin >> 1].reg
+    |= (pin.ulPin % 2) ? PORT_PMUX_PMUXO(BOARD_DAC_PERIPH) : PORT_PMUX_PMUXE(BOARD_DAC_PERIPH);
+  PORT->Group[pin.ulPort].PINCFG[pin.ulPin].reg |= PORT_PINCFG_PMUXEN;
+
+  dac->CTRLA.bit.ENABLE = 1;
+  while(dac->SYNCBUSY.bit.ENABLE);
+  while(!(dac->STATUS.reg & (DAC_STATUS_READY0 << channelNumber)));
+
+  channelsBegun |= (1 << channelNumber);
+  return true;
+}
+
+void DACModule::exitDAC() {
+  const PinDescription &pin = g_APinDescription[DAC_PINS[channelNumber]];
+  channelsBegun &= ~(1 << channelNumber);
+
+  dac->CTRLA.bit.ENABLE = 0;
+  while(dac->SYNCBUSY.bit.ENABLE);
+  dac->DACCTRL[channelNumber].reg = DAC_DACCTRL_RESETVALUE;
+
+  // Other channel still in use -> bring it back up
+  if (channelsBegun != 0) {
+    dac->CTRLA.bit.ENABLE = 1;
+    while(dac->SYNCBUSY.bit.ENABLE);
+  } else {
+    GCLK->PCHCTRL[DAC_GCLK_ID].reg = 0;
+    MCLK->APBDMASK.reg &= ~MCLK_APBDMASK_DAC;
+  }
+  PORT->Group[pin.ulPort].PINCFG[pin.ulPin].reg &= ~PORT_PINCFG_PMUXEN;
+}
+
+bool DACModule::initDMA() {
+  // Bandwidth reserved for the max rate -> rate can change while running
+  DMAChannelRequest request = { channelNumber, SUBSYSTEM_DAC, priorityClass,
+    System.tim.getTrigger(timer), DAC_DMA_BANDWIDTH, false, false };
+  channel = DMAUtility::allocateChannel(request);
+  if (channel == nullptr) {
+    currentError = ERROR_DAC_DMA;
+    return false;
+  }
+  // One sample per trigger -> pace is set by the timer alone
+  channel->settings
+    .setExternalTrigger(System.tim.getTrigger(timer))
+    .setTriggerAction(ACTION_TRANSFER_BURST)
+    .setBurstLength(1)
+    .setStandbyConfig(runStandby)
+    .setCallbackFunction(&DACDMACallback)
+    .setCallbackConfig(true, false, false);
+  return true;
+}
+
+void DACModule::exitDMA() {
+  if (channel == nullptr) return;
+  channel->disable(false);
+  DMA.freeChannel(channel);
+  channel = nullptr;
+}
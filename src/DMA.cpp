@@ -3,19 +3,24 @@
 
 //// FORWARD DECLARATIONS ////
 int16_t getTrigger(bool swTriggerFlag);
-void DMAC_0_Handler(void);
-
-void DMAC_1_Handler(void) __attribute__((weak, alias("DMAC_0_Handler")));  // Re-route all handlers to handler 0
-void DMAC_2_Handler(void) __attribute__((weak, alias("DMAC_0_Handler")));
-void DMAC_3_Handler(void) __attribute__((weak, alias("DMAC_0_Handler")));
-void DMAC_4_Handler(void) __attribute__((weak, alias("DMAC_0_Handler")));
+void channelISR(TransferChannel &channel);
+void dispatch(int16_t channelIndex);
+void setDispatch(int16_t channelIndex, DMAChannelISR handler);
+void updateDispatchPriority(int16_t channelIndex);
+void invokeCallback(TransferChannel &channel, DMA_CALLBACK_REASON reason);
+void asyncIRQHandler(DMA_CALLBACK_REASON reason, TransferChannel &source, 
+  int16_t descriptorIndex);
+void tuningIRQHandler(DMA_CALLBACK_REASON reason, TransferChannel &source, 
+  int16_t descriptorIndex);
 
 
 static __attribute__((__aligned__(16))) DmacDescriptor 
   primaryDescriptorArray[DMA_MAX_CHANNELS] SECTION_DMAC_DESCRIPTOR,
-  writebackDescriptorArray[DMA_MAX_CHANNELS] SECTION_DMAC_DESCRIPTOR;
+  writebackDescriptorArray[DMA_MAX_CHANNELS] SECTION_DMAC_DESCRIPTOR,
+  descriptorPool[DMA_POOL_SIZE] SECTION_DMAC_DESCRIPTOR;  // Linked (non-bound) descriptors
 
-DMAUtility &DMA;
+DMAUtility DMAUtility::instance;
+DMAUtility &DMA = DMAUtility::instance;
 
 bool DMAUtility::begun = false;
 int16_t DMAUtility::currentChannel = 0;
@@ -25,6 +30,19 @@ TransferChannel DMAUtility::channelArray[DMA_MAX_CHANNELS] = {
   TransferChannel(10), TransferChannel(11), TransferChannel(12), TransferChannel(13), TransferChannel(14),
   TransferChannel(15)
 };
+int16_t DMAUtility::poolNext[DMA_POOL_SIZE];
+int16_t DMAUtility::poolHead = -1;
+int16_t DMAUtility::poolUsage[DMA_MAX_CHANNELS] = { 0 };
+bool DMAUtility::poolReady = false;
+DMAUtility::AsyncSlot DMAUtility::asyncSlots[DMA_ASYNC_SLOTS] = { 0 };
+DMA_SUBSYSTEM DMAUtility::reservedFor[DMA_MAX_CHANNELS] = { SUBSYSTEM_NONE };
+DMAChannelRequest DMAUtility::channelRequest[DMA_MAX_CHANNELS] = {};
+uint32_t DMAUtility::bandwidthUsed = 0;
+
+// Dispatch -> handler of each active channel & channels grouped by priority level
+static DMAChannelISR isrTable[DMA_MAX_CHANNELS] = { nullptr };
+static volatile uint32_t priorityMask[DMA_PRIORITY_LVL_COUNT] = { 0 };
+static volatile uint32_t isrEntryCycles = 0; // CYCCNT @ vector entry (stats)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> DMA UTILITY
@@ -53,6 +71,14 @@ void DMAUtility::begin() {
     NVIC_SetPriority((IRQn_Type)(DMAC_0_IRQn + i), (1 << __NVIC_PRIO_BITS) - 1);  
     NVIC_EnableIRQ((IRQn_Type)(DMAC_0_IRQn + i));
   }
+  // Enable cycle counter for ISR latency stats
+  if (DMA_STATS_ENABLED) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+  // Channels 0 - 3 have their own vectors -> keep them for ADC data/control
+  reserveChannels(SUBSYSTEM_ADC, DMA_RESERVED_ADC);
+
   // Enable DMA
   DMAC->CTRL.bit.DMAENABLE = 1;
   begun = true; 
@@ -70,22 +96,30 @@ void DMAUtility::end() {
     NVIC_ClearPendingIRQ((IRQn_Type)(DMAC_0_IRQn + i));  
     NVIC_DisableIRQ((IRQn_Type)(DMAC_0_IRQn + i));
   }
-  // Clear all channels
+  // Give back async copy channels (jobs in flight are lost)
+  for (int16_t i = 0; i < DMA_ASYNC_SLOTS; i++) {
+    if (asyncSlots[i].channel != nullptr) freeChannel(asyncSlots[i].channel);
+    asyncSlots[i].channel = nullptr;
+    asyncSlots[i].busy = false;
+  }
+  // Free all channels -> requests & bandwidth booked for them go too (owners must re-allocate)
   for (int16_t i = 0; i < DMA_MAX_CHANNELS; i++) {      
-    channelArray[i].clear();
+    freeChannel(&channelArray[i]);
   }
   // Reset variables
+  for (int16_t i = 0; i < DMA_MAX_CHANNELS; i++) {
+    reservedFor[i] = SUBSYSTEM_NONE;
+  }
+  memset(channelRequest, 0, sizeof(channelRequest));
+  bandwidthUsed = 0;
   currentChannel = 0;
   begun = false;
 }
 
 
+// Note -> does not allocate (see allocateChannel), check isAllocated() before use
 TransferChannel &DMAUtility::getChannel(int16_t channelIndex) {
   CLAMP(channelIndex, 0, DMA_MAX_CHANNELS - 1);
-  if (!channelArray[channelIndex].allocated) {
-    channelArray[channelIndex].init(-1);
-    channelArray[channelIndex].allocated = true;
-  }
   return channelArray[channelIndex];
 }
 
@@ -96,20 +130,67 @@ TransferChannel &DMAUtility::operator[] (int16_t channelIndex) {
 
 
 TransferChannel *DMAUtility::allocateChannel(int16_t ownerID) {
-  if (ownerID < -1) ownerID = -1;
-
-  // Iterate through channels to find one that is not allocated
-  for (int16_t i = 0; i < DMA_MAX_CHANNELS; i++) {
-    if (channelArray[i].allocated == false) {
-
-      // Channel found -> initialize channel
-      TransferChannel &allocCH = channelArray[i];
-      allocCH.allocated = true;
-      allocCH.init(ownerID);
-      return &allocCH;
+  DMAChannelRequest request = { ownerID, SUBSYSTEM_USER, CLASS_NORMAL, TRIGGER_SOFTWARE, 0,
+    false, false };
+  return allocateChannel(request);
+}
+
+// Reserved channels of the subsystem are used first. Otherwise realtime requests take the lowest
+// free channel (own IRQ vector), the rest fill from the top down to keep low channels free.
+// Event requests may take another subsystem's reserved channel, event lines are only on 0 - 7.
+TransferChannel *DMAUtility::allocateChannel(const DMAChannelRequest &request) {
+  int16_t ownerID = (request.ownerID < -1) ? -1 : request.ownerID;
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (request.bytesPerSecond > DMA_BANDWIDTH_BUDGET - bandwidthUsed) {
+    if (!primask) __enable_irq();
+    return nullptr;
+  }
+  // Event lines only exist on the low channels
+  int16_t limit = DMA_MAX_CHANNELS;
+  if (request.eventOutput) {
+    limit = DMA_EVENT_OUTPUT_CHANNELS;
+  } else if (request.eventInput) {
+    limit = DMA_EVENT_INPUT_CHANNELS;
+  }
+  int16_t found = -1;
+  for (int16_t i = 0; i < limit && found == -1; i++) {
+    if (!channelArray[i].allocated && reservedFor[i] != SUBSYSTEM_NONE 
+    && reservedFor[i] == request.subsystem) {
+      found = i;
     }
   }
-  return nullptr;
+  for (int16_t n = 0; n < limit && found == -1; n++) {
+    int16_t i = (request.priorityClass == CLASS_REALTIME) ? n : limit - 1 - n;
+    if (!channelArray[i].allocated && reservedFor[i] == SUBSYSTEM_NONE) {
+      found = i;
+    }
+  }
+  // Event lines are all reserved -> borrow the highest free one (reservations fill low first)
+  if (found == -1 && (request.eventOutput || request.eventInput)) {
+    for (int16_t i = limit - 1; i >= 0 && found == -1; i--) {
+      if (!channelArray[i].allocated) found = i;
+    }
+  }
+  if (found == -1) {
+    if (!primask) __enable_irq();
+    return nullptr;
+  }
+  // Channel found -> claim it before unmasking, then initialize
+  TransferChannel &allocCH = channelArray[found];
+  allocCH.allocated = true;
+  channelRequest[found] = request;
+  channelRequest[found].ownerID = ownerID;
+  bandwidthUsed += request.bytesPerSecond;
+  if (!primask) __enable_irq();
+
+  allocCH.init(ownerID);
+  allocCH.settings.setPriorityLevel(request.priorityClass);
+  if (request.trigger != TRIGGER_SOFTWARE) {
+    allocCH.settings.setExternalTrigger(request.trigger);
+  }
+  return &allocCH;
 }
 TransferChannel *DMAUtility::allocateChannel() {
   return allocateChannel(-1);
@@ -118,23 +199,64 @@ TransferChannel *DMAUtility::allocateChannel() {
 
 void DMAUtility::freeChannel(int16_t channelIndex) {
   CLAMP(channelIndex, 0, DMA_MAX_CHANNELS - 1);
-  TransferChannel &targChannel = channelArray[channelIndex];
-
-  // Clear channel and reset alloc flag/id
-  targChannel.clear();
-  targChannel.allocated = false;
-  targChannel.ownerID = -1;
+  freeChannel(&channelArray[channelIndex]);
 }
 
 
-void DMAUtility::freeChannel(TransferChannel *channel) {         ////////// ADD ASSERT -> CHANNEL NOT NULL
+void DMAUtility::freeChannel(TransferChannel *channel) {
+  if (channel == nullptr) return;
+
+  // Give bandwidth back (once -> channel may be freed twice by owners)
+  if (channel->allocated) {
+    bandwidthUsed -= channelRequest[channel->channelIndex].bytesPerSecond;
+    memset(&channelRequest[channel->channelIndex], 0, sizeof(DMAChannelRequest));
+  }
+  setDispatch(channel->channelIndex, nullptr);
   channel->clear();
   channel->allocated = false;
   channel->ownerID = -1;
-  channel = nullptr;
 }
 
 
+// Returns channels reserved (lowest free first), reserved channels only go to that subsystem
+int16_t DMAUtility::reserveChannels(DMA_SUBSYSTEM subsystem, int16_t count) {
+  if (subsystem == SUBSYSTEM_NONE) return 0;
+  int16_t reserved = 0;
+  for (int16_t i = 0; i < DMA_MAX_CHANNELS && reserved < count; i++) {
+    if (!channelArray[i].allocated && reservedFor[i] == SUBSYSTEM_NONE) {
+      reservedFor[i] = subsystem;
+      reserved++;
+    }
+  }
+  return reserved;
+}
+
+
+void DMAUtility::releaseReservation(DMA_SUBSYSTEM subsystem) {
+  for (int16_t i = 0; i < DMA_MAX_CHANNELS; i++) {
+    if (reservedFor[i] == subsystem) reservedFor[i] = SUBSYSTEM_NONE;
+  }
+}
+
+
+// Fills one entry per channel (up to tableSize), returns entries written
+int16_t DMAUtility::getUtilization(DMAChannelUsage *table, int16_t tableSize) {
+  if (table == nullptr) return 0;
+  int16_t count = MIN(tableSize, DMA_MAX_CHANNELS);
+  for (int16_t i = 0; i < count; i++) {
+    table[i].channelIndex = i;
+    table[i].allocated = channelArray[i].allocated;
+    table[i].reservedFor = reservedFor[i];
+    table[i].request = channelRequest[i];
+    table[i].priorityLevel = DMAC->Channel[i].CHPRILVL.bit.PRILVL;
+  }
+  return count;
+}
+
+
+uint32_t DMAUtility::bandwidthFree() { return DMA_BANDWIDTH_BUDGET - bandwidthUsed; }
+
+
 void DMAUtility::resetChannel(TransferChannel *channel) {
   // If null or not alloc'd -> no ability/reason to reset
   if (channel == nullptr) {
@@ -154,6 +276,340 @@ void DMAUtility::resetChannel(int16_t channelIndex) {
   resetChannel(&channelArray[channelIndex]);
 }
 
+
+int16_t DMAUtility::descriptorsFree() {
+  int16_t used = 0;
+  for (int16_t i = 0; i < DMA_MAX_CHANNELS; i++) {
+    used += poolUsage[i];
+  }
+  return DMA_POOL_SIZE - used;
+}
+
+
+// Pool descriptors linked by a channel, 0 for an out of range index
+int16_t DMAUtility::descriptorsUsed(int16_t channelIndex) {
+  if (channelIndex < 0 || channelIndex >= DMA_MAX_CHANNELS) return 0;
+  return poolUsage[channelIndex];
+}
+
+
+// Note -> does not allocate (unlike getChannel), false if channel unused
+bool DMAUtility::getStats(int16_t channelIndex, DMAChannelStats &snapshot) {
+  if (channelIndex < 0 || channelIndex >= DMA_MAX_CHANNELS
+  || !channelArray[channelIndex].allocated) {
+    return false;
+  }
+  return channelArray[channelIndex].getStats(snapshot);
+}
+
+
+void DMAUtility::clearStats() {
+  for (int16_t i = 0; i < DMA_MAX_CHANNELS; i++) {
+    channelArray[i].clearStats();
+  }
+}
+
+
+// O(1) & safe from ISRs -> free list of pool indices
+DmacDescriptor *DMAUtility::allocDescriptor(int16_t channelIndex) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // First use -> link every slot into the free list
+  if (!poolReady) {
+    for (int16_t i = 0; i < DMA_POOL_SIZE; i++) {
+      poolNext[i] = (i + 1 < DMA_POOL_SIZE) ? i + 1 : -1;
+    }
+    poolHead = 0;
+    poolReady = true;
+  }
+  if (poolHead == -1) {
+    if (!primask) __enable_irq();
+    return nullptr;
+  }
+  int16_t index = poolHead;
+  poolHead = poolNext[index];
+  poolUsage[channelIndex]++;
+  if (!primask) __enable_irq();
+
+  memset(&descriptorPool[index], 0, sizeof(DmacDescriptor));
+  return &descriptorPool[index];
+}
+
+
+// Note -> descriptors outside of the pool (bound/primary) are ignored
+void DMAUtility::freeDescriptor(DmacDescriptor *descriptor, int16_t channelIndex) {
+  if (descriptor < &descriptorPool[0] || descriptor >= &descriptorPool[DMA_POOL_SIZE]) return;
+  int16_t index = descriptor - descriptorPool;
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  poolNext[index] = poolHead;
+  poolHead = index;
+  if (poolUsage[channelIndex] > 0) poolUsage[channelIndex]--;
+  if (!primask) __enable_irq();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> ASYNC COPY
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Note -> dest & source must stay valid until the job is done (see isDone/wait/callback)
+DMAHandle DMAUtility::copyAsync(void *destination, const void *source, uint32_t numBytes,
+  DMAAsyncCallback callback) {
+  return startAsync(destination, source, numBytes, false, 0, callback);
+}
+
+
+DMAHandle DMAUtility::fillAsync(void *destination, uint8_t value, uint32_t numBytes,
+  DMAAsyncCallback callback) {
+  return startAsync(destination, nullptr, numBytes, true, value, callback);
+}
+
+
+bool DMAUtility::isDone(DMAHandle handle) {
+  if (handle.slot < 0 || handle.slot >= DMA_ASYNC_SLOTS) return true;
+  AsyncSlot &slot = asyncSlots[handle.slot];
+
+  // Slot moved on to a newer job -> this one finished
+  return slot.generation != handle.generation || !slot.busy;
+}
+
+
+// Note -> spins, timeout in micros
+bool DMAUtility::wait(DMAHandle handle, uint32_t timeout) {
+  uint32_t start = micros();
+  while (!isDone(handle) && micros() - start < timeout);
+  return isDone(handle);
+}
+
+
+ERROR_ID DMAUtility::asyncError(DMAHandle handle) {
+  if (handle.slot < 0 || handle.slot >= DMA_ASYNC_SLOTS) return ERROR_SETTINGS_INVALID;
+  AsyncSlot &slot = asyncSlots[handle.slot];
+  return (slot.generation == handle.generation) ? slot.error : ERROR_NONE;
+}
+
+
+DMAHandle DMAUtility::startAsync(void *destination, const void *source, uint32_t numBytes,
+  bool fill, uint8_t fillValue, DMAAsyncCallback callback) {
+  static TransferDescriptor chain[DMA_MAX_CHAIN_LENGTH];
+  static TransferDescriptor *chainPtr[DMA_MAX_CHAIN_LENGTH];
+  DMAHandle handle = { -1, 0 };
+  if (!begun || destination == nullptr || (!fill && source == nullptr) || numBytes == 0) {
+    return handle;
+  }
+  // Widest beat both addresses allow, remainder goes out as a byte beat tail
+  uint32_t dest = (uint32_t)destination;
+  DMATuning tuning = tune(fill ? 0 : (uint32_t)source, dest, numBytes);
+  int16_t beatSize = tuning.beatSize;
+  uint32_t beats = numBytes / beatSize;
+  uint32_t tailBytes = numBytes % beatSize;
+  int16_t blockCount = (beats + DMA_MAX_BEATS - 1) / DMA_MAX_BEATS + (tailBytes > 0);
+  if (blockCount > DMA_MAX_CHAIN_LENGTH) return handle;
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // Find idle slot -> descriptors of finished jobs go back to the pool on the way
+  int16_t slotIndex = -1;
+  for (int16_t i = 0; i < DMA_ASYNC_SLOTS; i++) {
+    if (asyncSlots[i].busy) continue;
+    if (asyncSlots[i].channel != nullptr) asyncSlots[i].channel->clearDescriptors();
+    if (slotIndex == -1) slotIndex = i;
+  }
+  if (slotIndex == -1) {
+    if (!primask) __enable_irq();
+    return handle;
+  }
+  AsyncSlot &slot = asyncSlots[slotIndex];
+  if (slot.channel == nullptr) {
+    DMAChannelRequest request = { slotIndex, SUBSYSTEM_ASYNC, CLASS_BACKGROUND, 
+      TRIGGER_SOFTWARE, 0, false, false };
+    slot.channel = allocateChannel(request);
+    if (slot.channel == nullptr) {
+      if (!primask) __enable_irq();
+      return handle;
+    }
+    slot.channel->settings
+      .setCallbackFunction(asyncIRQHandler)
+      .setCallbackConfig(true, true, false);
+  }
+  // Channel is idle here (last job ended or never ran) -> burst & threshold can be changed
+  slot.channel->settings.setTuning(tuning);
+  slot.pattern = fillValue * 0x01010101ul;
+
+  // Build chain -> fill reads the same pattern word every beat (no source increment)
+  uint32_t offset = 0;
+  for (int16_t i = 0; i < blockCount; i++) {
+    bool tail = (tailBytes > 0 && i == blockCount - 1);
+    int16_t size = tail ? 1 : beatSize;
+    uint16_t count = tail ? tailBytes : MIN(beats - offset / beatSize, (uint32_t)DMA_MAX_BEATS);
+
+    chain[i].setDefault();
+    chain[i].setDataSize(size)
+      .setIncrementConfig(!fill, true)
+      .setTransferAmount(count)
+      .setAction(i == blockCount - 1 ? ACTION_BLOCK_INTERRUPT : ACTION_NONE)
+      .setDestination(dest + offset, true);
+    if (fill) {
+      chain[i].setSource((uint32_t)&slot.pattern, false);
+    } else {
+      chain[i].setSource((uint32_t)source + offset, true);
+    }
+    chainPtr[i] = &chain[i];
+    offset += (uint32_t)count * size;
+  }
+  if (!slot.channel->setDescriptors(chainPtr, blockCount, false, false)
+  || !slot.channel->enable()) {
+    if (!primask) __enable_irq();
+    return handle;
+  }
+  slot.generation++;
+  slot.busy = true;
+  slot.error = ERROR_NONE;
+  slot.callback = callback;
+
+  if (!slot.channel->trigger()) {
+    slot.busy = false;
+    slot.error = ERROR_DMA_TRANSFER;
+  }
+  handle.slot = slotIndex;
+  handle.generation = slot.generation;
+  if (!primask) __enable_irq();
+  return handle;
+}
+
+
+// Called on the last block of a job (only one with an interrupt) or on error
+void asyncIRQHandler(DMA_CALLBACK_REASON reason, TransferChannel &source, 
+  int16_t descriptorIndex) {
+  int16_t slotIndex = source.getOwnerID();
+  if (slotIndex < 0 || slotIndex >= DMA_ASYNC_SLOTS) return;
+  DMAUtility::AsyncSlot &slot = DMAUtility::asyncSlots[slotIndex];
+  if (!slot.busy || slot.channel != &source) return;
+  if (reason != REASON_TRANSFER_COMPLETE_STOPPED && reason != REASON_ERROR) return;
+
+  slot.error = (reason == REASON_ERROR) ? source.getError() : ERROR_NONE;
+  slot.busy = false;
+  if (slot.callback != nullptr) {
+    DMAHandle handle = { slotIndex, slot.generation };
+    slot.callback(handle, slot.error);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> TRANSFER TUNING
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static volatile bool tuningDone = false;
+static volatile uint32_t tuningDoneCycles = 0;
+
+// Widest legal beat, burst & threshold for a move. peripheralBeat != 0 -> one side is a peripheral
+// register of that width -> beat is fixed & each trigger moves one beat (burst & threshold 1).
+// Note -> last burst of a block may be short, burst does not need to divide the beat count
+DMATuning DMAUtility::tune(uint32_t source, uint32_t destination, uint32_t numBytes,
+  int16_t peripheralBeat) {
+  DMATuning tuning = { 1, 1, 1, ACTION_TRANSFER_BURST };
+  if (peripheralBeat == 1 || peripheralBeat == 2 || peripheralBeat == 4) {
+    tuning.beatSize = peripheralBeat;
+    return tuning;
+  }
+  // Memory -> widest beat both addresses allow, longest burst, widest threshold that fits it
+  uint32_t addrBits = source | destination;
+  if ((addrBits & 3) == 0 && numBytes >= 4) {
+    tuning.beatSize = 4;
+  } else if ((addrBits & 1) == 0 && numBytes >= 2) {
+    tuning.beatSize = 2;
+  }
+  uint32_t beats = numBytes / tuning.beatSize;
+  tuning.burstLength = MAX(MIN(beats, (uint32_t)DMA_TUNING_MAX_BURST), 1ul);
+  while (tuning.threshold * 2 <= MIN(tuning.burstLength, DMA_TUNING_MAX_THRESHOLD)) {
+    tuning.threshold *= 2;
+  }
+  tuning.triggerAction = ACTION_TRANSFER_ALL;
+  return tuning;
+}
+
+
+// Moves the data once per beat/burst/threshold combination on a scratch channel & times trigger
+// to completion callback. Sorted fastest first -> results[0].tuning is the one to use.
+// Note -> blocking, numBytes must fit one block at byte beats (DMA_MAX_BEATS)
+int16_t DMAUtility::benchmarkTuning(void *destination, const void *source, uint16_t numBytes,
+  DMATuningResult *results, int16_t maxResults) {
+  if (!begun || destination == nullptr || source == nullptr || numBytes == 0
+  || results == nullptr || maxResults <= 0) {
+    return 0;
+  }
+  DMAChannelRequest request = { -1, SUBSYSTEM_USER, CLASS_BACKGROUND, TRIGGER_SOFTWARE, 0,
+    false, false };
+  TransferChannel *channel = allocateChannel(request);
+  if (channel == nullptr) return 0;
+  channel->settings
+    .setCallbackFunction(tuningIRQHandler)
+    .setCallbackConfig(true, true, false);
+
+  // Cycle counter may be off if stats are disabled
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  DMATuning widest = tune((uint32_t)source, (uint32_t)destination, numBytes);
+  TransferDescriptor desc;
+  int16_t count = 0;
+
+  for (int16_t beatSize = 1; beatSize <= widest.beatSize; beatSize <<= 1) {
+    if (numBytes % beatSize != 0) continue;
+
+    for (int16_t burst = 1; burst <= DMA_TUNING_MAX_BURST; burst <<= 1) {
+      for (int16_t threshold = 1; threshold <= MIN(burst, DMA_TUNING_MAX_THRESHOLD); 
+        threshold <<= 1) {
+        DMATuning tuning = { beatSize, burst, threshold, ACTION_TRANSFER_ALL };
+        desc.setDefault();
+        desc.setDataSize(beatSize)
+          .setIncrementConfig(true, true)
+          .setTransferAmount(numBytes / beatSize)
+          .setAction(ACTION_BLOCK_INTERRUPT)
+          .setSource((uint32_t)source, true)
+          .setDestination((uint32_t)destination, true);
+
+        channel->disable(true);
+        if (!channel->setDescriptor(&desc, false)) continue;
+        channel->settings.setTuning(tuning);
+        tuningDone = false;
+        channel->enable();
+        uint32_t startCycles = DWT->CYCCNT;
+        channel->trigger();
+
+        uint32_t startMicros = micros();
+        while (!tuningDone && micros() - startMicros < DMA_TUNING_TIMEOUT);
+        if (!tuningDone) continue;
+        uint32_t cycles = MAX(tuningDoneCycles - startCycles, 1ul);
+
+        // Insert sorted, drop slowest once full
+        if (count == maxResults && cycles >= results[count - 1].cycles) continue;
+        int16_t pos = (count < maxResults) ? count++ : count - 1;
+        while (pos > 0 && results[pos - 1].cycles > cycles) {
+          results[pos] = results[pos - 1];
+          pos--;
+        }
+        results[pos].tuning = tuning;
+        results[pos].cycles = cycles;
+        results[pos].bytesPerMicro = (float)numBytes * (F_CPU / 1000000ul) / cycles;
+      }
+    }
+  }
+  channel->disable(true);
+  instance.freeChannel(channel);
+  return count;
+}
+
+void tuningIRQHandler(DMA_CALLBACK_REASON reason, TransferChannel &source, 
+  int16_t descriptorIndex) {
+  if (reason != REASON_TRANSFER_COMPLETE_STOPPED && reason != REASON_ERROR) return;
+  tuningDoneCycles = DWT->CYCCNT;
+  tuningDone = (reason == REASON_TRANSFER_COMPLETE_STOPPED);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> DMA INTERRUPT FUNCTION
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -167,9 +623,82 @@ int16_t getTrigger(bool swTriggerFlag) {
   return 0;
 }
 
-void DMAC_0_Handler(void) {
-  TransferChannel &channel = DMA.getChannel(DMAC->INTPEND.bit.ID);
+void setDispatch(int16_t channelIndex, DMAChannelISR handler) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  isrTable[channelIndex] = handler;
+  updateDispatchPriority(channelIndex);
+  if (!primask) __enable_irq();
+}
+
+void updateDispatchPriority(int16_t channelIndex) {
+  uint32_t bit = (1ul << channelIndex);
+  for (int16_t i = 0; i < DMA_PRIORITY_LVL_COUNT; i++) {
+    priorityMask[i] &= ~bit;
+  }
+  if (isrTable[channelIndex] != nullptr) {
+    priorityMask[DMAC->Channel[channelIndex].CHPRILVL.bit.PRILVL] |= bit;
+  }
+}
+
+void dispatch(int16_t channelIndex) {
+  DMAChannelISR handler = isrTable[channelIndex];
+  if (handler != nullptr) {
+    handler(DMAUtility::channelArray[channelIndex]);
+
+  // No owner -> clear flags so the line does not stay asserted
+  } else {
+    DMAC->Channel[channelIndex].CHINTFLAG.reg = DMAC_CHINTFLAG_MASK;
+  }
+}
+
+// Channels 0 - 3 -> dedicated lines, no lookup
+void DMAC_0_Handler(void) { if (DMA_STATS_ENABLED) isrEntryCycles = DWT->CYCCNT; dispatch(0); }
+void DMAC_1_Handler(void) { if (DMA_STATS_ENABLED) isrEntryCycles = DWT->CYCCNT; dispatch(1); }
+void DMAC_2_Handler(void) { if (DMA_STATS_ENABLED) isrEntryCycles = DWT->CYCCNT; dispatch(2); }
+void DMAC_3_Handler(void) { if (DMA_STATS_ENABLED) isrEntryCycles = DWT->CYCCNT; dispatch(3); }
+
+// Channels 4+ -> drain every pending channel, highest priority level first
+// Note -> latency of later channels includes time spent on earlier ones (shows starvation)
+void DMAC_4_Handler(void) {
+  if (DMA_STATS_ENABLED) isrEntryCycles = DWT->CYCCNT;
+  for (int16_t pass = 0; pass < DMA_ISR_MAX_PASSES; pass++) {
+    uint32_t pending = DMAC->INTSTATUS.reg & DMA_SHARED_IRQ_MASK;
+    if (pending == 0) return;
+
+    for (int16_t lvl = DMA_PRIORITY_LVL_COUNT - 1; lvl >= 0; lvl--) {
+      uint32_t lvlPending = pending & priorityMask[lvl];
+      pending &= ~lvlPending;
+
+      while (lvlPending) {
+        int16_t channelIndex = __builtin_ctz(lvlPending);
+        lvlPending &= lvlPending - 1;
+        dispatch(channelIndex);
+      }
+    }
+    // Pending but not in any mask (no owner) -> clear
+    while (pending) {
+      int16_t channelIndex = __builtin_ctz(pending);
+      pending &= pending - 1;
+      dispatch(channelIndex);
+    }
+  }
+}
+
+void invokeCallback(TransferChannel &channel, DMA_CALLBACK_REASON reason) {
+  if (DMA_STATS_ENABLED) {
+    uint32_t cycles = DWT->CYCCNT - isrEntryCycles;
+    channel.stats.callbacks++;
+    channel.stats.callbackCycles = cycles;
+    channel.stats.callbackCyclesTotal += cycles;
+    if (cycles > channel.stats.callbackCyclesMax) channel.stats.callbackCyclesMax = cycles;
+  }
+  channel.callback(reason, channel, channel.currentDescriptor);
+}
+
+void channelISR(TransferChannel &channel) {
   DMA_CALLBACK_REASON completeReason = REASON_UNKNOWN;
+  if (DMA_STATS_ENABLED) channel.stats.interrupts++;
 
   // If reset called -> re-enable channel
   if (channel.syncStatus == 3) {
@@ -189,28 +718,31 @@ void DMAC_0_Handler(void) {
     channel.swTriggerFlag = false;
     channel.swPendFlag = false;
     channel.syncStatus = 0;
+    if (DMA_STATS_ENABLED) channel.stats.errors++;
 
     if (channel.errorCallbacks && channel.callback != nullptr) {
-      channel.callback(REASON_ERROR, channel, channel.currentDescriptor);
+      invokeCallback(channel, REASON_ERROR);
     }
     // Clear flag
-    DMAC->Channel[channel.channelIndex].CHINTFLAG.bit.TERR = 1;
+    DMAC->Channel[channel.channelIndex].CHINTFLAG.reg = DMAC_CHINTFLAG_TERR;
 
   // Channel suspended
   } else if (DMAC->Channel[channel.channelIndex].CHINTFLAG.bit.SUSP) {
       
+    if (DMA_STATS_ENABLED) channel.stats.suspends++;
     if (channel.suspendFlag) {
 
       if (channel.suspendCallbacks && channel.callback != nullptr) {
-        channel.callback(REASON_SUSPENDED, channel, channel.currentDescriptor);
+        invokeCallback(channel, REASON_SUSPENDED);
       }
 
     } else if (DMAC->Channel[channel.channelIndex].CHSTATUS.bit.FERR) {
       channel.suspendFlag = true;
       channel.currentError = ERROR_DMA_DESCRIPTOR;
+      if (DMA_STATS_ENABLED) channel.stats.errors++;
 
       if (channel.errorCallbacks && channel.callback != nullptr) {
-        channel.callback(REASON_ERROR, channel, channel.currentDescriptor);
+        invokeCallback(channel, REASON_ERROR);
       }
 
     } else if (writebackDescriptorArray[channel.channelIndex].BTCTRL.bit.BLOCKACT
@@ -220,10 +752,11 @@ void DMAC_0_Handler(void) {
         channel.currentError = ERROR_NONE;
         
         completeReason = REASON_TRANSFER_COMPLETE_SUSPENDED;
+        DMAC->Channel[channel.channelIndex].CHINTFLAG.reg = DMAC_CHINTFLAG_SUSP;
         goto transferComplete;
     } 
     // Clear flag
-    DMAC->Channel[channel.channelIndex].CHINTFLAG.bit.SUSP;
+    DMAC->Channel[channel.channelIndex].CHINTFLAG.reg = DMAC_CHINTFLAG_SUSP;
 
   // Transfer complete
   } else if (DMAC->Channel[channel.channelIndex].CHINTFLAG.bit.TCMPL) {
@@ -236,6 +769,11 @@ void DMAC_0_Handler(void) {
       channel.swPendFlag = false;
 
       if (writebackDescriptorArray[channel.channelIndex].BTCNT.bit.BTCNT == 0) {
+        DmacDescriptor *done = channel.getDescriptor(channel.currentDescriptor);
+        if (DMA_STATS_ENABLED && done != nullptr) {
+          channel.stats.blocksCompleted++;
+          channel.stats.bytesMoved += done->BTCNT.bit.BTCNT * (1 << done->BTCTRL.bit.BEATSIZE);
+        }
         channel.currentDescriptor++;
 
         if (channel.currentDescriptor >= channel.descriptorCount) {
@@ -243,11 +781,11 @@ void DMAC_0_Handler(void) {
         }
       }
       if (channel.transferCompleteCallbacks && channel.callback != nullptr) {
-        channel.callback(completeReason, channel, channel.currentDescriptor);
+        invokeCallback(channel, completeReason);
       }
     }
-    // Clear flag
-    DMAC->Channel[channel.channelIndex].CHINTFLAG.bit.TCMPL;
+    // Clear flag (write-one-to-clear -> dont touch other flags)
+    DMAC->Channel[channel.channelIndex].CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL;
   }
 }
 
@@ -301,11 +839,11 @@ TransferDescriptor &TransferDescriptor::setSource(uint32_t sourceAddr,
     baseSourceAddr = sourceAddr;
     if (currentDesc->BTCTRL.bit.STEPSEL && currentDesc->BTCTRL.bit.SRCINC) {
       currentDesc->SRCADDR.bit.SRCADDR = sourceAddr + (currentDesc->BTCNT.bit.BTCNT 
-        * (currentDesc->BTCTRL.bit.BEATSIZE + 1) 
+        * (1 << currentDesc->BTCTRL.bit.BEATSIZE) 
         * (1 << currentDesc->BTCTRL.bit.STEPSIZE)); 
     } else {
       currentDesc->SRCADDR.bit.SRCADDR = sourceAddr + (currentDesc->BTCNT.bit.BTCNT
-        * (currentDesc->BTCTRL.bit.BEATSIZE + 1));
+        * (1 << currentDesc->BTCTRL.bit.BEATSIZE));
     }   
   } else {
     currentDesc->SRCADDR.bit.SRCADDR = sourceAddr;
@@ -317,7 +855,7 @@ TransferDescriptor &TransferDescriptor::setSource(uint32_t sourceAddr,
 TransferDescriptor &TransferDescriptor::setSource(void *sourcePtr, bool correctAddress) {
   if (sourcePtr != nullptr) {
     uint32_t addr = reinterpret_cast<uint32_t>(sourcePtr);
-    setDestination(addr, correctAddress);
+    setSource(addr, correctAddress);
   }
   return *this;
 }
@@ -329,11 +867,11 @@ TransferDescriptor &TransferDescriptor::setDestination(uint32_t destinationAddr,
     baseDestAddr = destinationAddr;
     if (!currentDesc->BTCTRL.bit.STEPSEL && currentDesc->BTCTRL.bit.DSTINC) {
       currentDesc->DSTADDR.bit.DSTADDR = destinationAddr + (currentDesc->BTCNT.bit.BTCNT
-        * (currentDesc->BTCTRL.bit.BEATSIZE + 1)
+        * (1 << currentDesc->BTCTRL.bit.BEATSIZE)
         * (1 << currentDesc->BTCTRL.bit.STEPSIZE));
     } else {
       currentDesc->DSTADDR.bit.DSTADDR = destinationAddr + (currentDesc->BTCNT.bit.BTCNT
-        * (currentDesc->BTCTRL.bit.BEATSIZE + 1));
+        * (1 << currentDesc->BTCTRL.bit.BEATSIZE));
     }
   } else {
     currentDesc->DSTADDR.bit.DSTADDR = destinationAddr;
@@ -412,6 +950,12 @@ TransferDescriptor &TransferDescriptor::setAction(DMA_TRANSFER_ACTION action) {
   return *this;
 }
 
+// Note -> strobe only leaves the DMAC if the channel has its event output enabled
+TransferDescriptor &TransferDescriptor::setEventOutput(DMA_EVENT_OUTPUT output) {
+  currentDesc->BTCTRL.bit.EVOSEL = (uint8_t)output;
+  return *this;
+}
+
 bool TransferDescriptor::isValid() {
   if (currentDesc->BTCNT.bit.BTCNT != 0
   && currentDesc->DSTADDR.bit.DSTADDR != 0
@@ -464,10 +1008,13 @@ TransferChannel::TransferSettings::TransferSettings(TransferChannel *super) {
   this->super = super;
 }
 
+// THRESHOLD is log2 encoded -> 1, 2, 4 or 8 beats (rounded down)
 TransferChannel::TransferSettings &TransferChannel::TransferSettings::setTransferThreshold(int16_t elements) {
-  elements -= 1; 
-  CLAMP(elements, 0, DMAC_CHCTRLA_THRESHOLD_8BEATS_Val);
-  DMAC->Channel[super->channelIndex].CHCTRLA.bit.THRESHOLD = elements;
+  int16_t value = 0;
+  while (value < (int16_t)DMAC_CHCTRLA_THRESHOLD_8BEATS_Val && (2 << value) <= elements) {
+    value++;
+  }
+  DMAC->Channel[super->channelIndex].CHCTRLA.bit.THRESHOLD = value;
   return *this;
 }
 
@@ -483,6 +1030,14 @@ TransferChannel::TransferSettings &TransferChannel::TransferSettings::setTrigger
   return *this;
 }
 
+// Note -> channel must be disabled (burst & threshold are enable protected)
+TransferChannel::TransferSettings &TransferChannel::TransferSettings::setTuning(const DMATuning &tuning) {
+  setBurstLength(tuning.burstLength);
+  setTransferThreshold(tuning.threshold);
+  setTriggerAction(tuning.triggerAction);
+  return *this;
+}
+
 TransferChannel::TransferSettings &TransferChannel::TransferSettings::setStandbyConfig(bool enabledDurringStandby) {
   if (enabledDurringStandby) {
     DMAC->Channel[super->channelIndex].CHCTRLA.bit.RUNSTDBY = 1;
@@ -495,6 +1050,7 @@ TransferChannel::TransferSettings &TransferChannel::TransferSettings::setStandby
 TransferChannel::TransferSettings &TransferChannel::TransferSettings::setPriorityLevel(int16_t level) {
   CLAMP(level, 0, 3);
   DMAC->Channel[super->channelIndex].CHPRILVL.bit.PRILVL = level;
+  updateDispatchPriority(super->channelIndex);
   return *this;
 }
 
@@ -542,6 +1098,33 @@ void TransferChannel::TransferSettings::removeExternalTrigger() {
   super->externalTrigger = TRIGGER_SOFTWARE;
 }
 
+// Sets EVOSEL on every descriptor the channel holds -> ones set later need setEventOutput().
+// Note -> only channels 0 - 3 have event outputs
+TransferChannel::TransferSettings &TransferChannel::TransferSettings::setEventOutput(
+  DMA_EVENT_OUTPUT output) {
+  if (super->channelIndex >= DMA_EVENT_OUTPUT_CHANNELS) {
+    super->currentError = ERROR_DMA_EVENT;
+    return *this;
+  }
+  for (int16_t i = 0; i < super->descriptorCount; i++) {
+    super->descriptorTable[i]->BTCTRL.bit.EVOSEL = (uint8_t)output;
+  }
+  DMAC->Channel[super->channelIndex].CHEVCTRL.bit.EVOE = (output != EVENT_OUTPUT_NONE);
+  return *this;
+}
+
+// EVENT_ACTION_NONE turns the input off. Note -> only channels 0 - 7 have event inputs
+TransferChannel::TransferSettings &TransferChannel::TransferSettings::setEventInput(
+  DMA_EVENT_ACTION action) {
+  if (super->channelIndex >= DMA_EVENT_INPUT_CHANNELS) {
+    super->currentError = ERROR_DMA_EVENT;
+    return *this;
+  }
+  DMAC->Channel[super->channelIndex].CHEVCTRL.bit.EVACT = (uint8_t)action;
+  DMAC->Channel[super->channelIndex].CHEVCTRL.bit.EVIE = (action != EVENT_ACTION_NONE);
+  return *this;
+}
+
 void TransferChannel::TransferSettings::equals(TransferChannel &other) {
   DMAC->Channel[super->channelIndex].CHCTRLA.reg &= ~DMAC_CHCTRLA_MASK;
   DMAC->Channel[super->channelIndex].CHCTRLA.reg
@@ -549,6 +1132,7 @@ void TransferChannel::TransferSettings::equals(TransferChannel &other) {
 
   DMAC->Channel[super->channelIndex].CHPRILVL.bit.PRILVL 
     = DMAC->Channel[other.channelIndex].CHPRILVL.bit.PRILVL;
+  updateDispatchPriority(super->channelIndex);
 
   super->callback = other.callback;
   super->externalTrigger = other.externalTrigger;
@@ -570,6 +1154,8 @@ void TransferChannel::TransferSettings::setDefault() {
   DMAC->Channel[super->channelIndex].CHCTRLA.bit.TRIGSRC = DMA_DEFAULT_TRIGGER_SOURCE;
   DMAC->Channel[super->channelIndex].CHPRILVL.bit.PRILVL = DMA_DEFAULT_PRIORITY_LVL;
   DMAC->Channel[super->channelIndex].CHCTRLA.bit.RUNSTDBY = DMA_DEFAULT_RUN_STANDBY;
+  DMAC->Channel[super->channelIndex].CHEVCTRL.reg = 0;
+  updateDispatchPriority(super->channelIndex);
 
   super->callback = nullptr;
   super->externalTrigger = DMA_DEFAULT_TRIGGER_SOURCE;
@@ -600,6 +1186,9 @@ TransferChannel::TransferChannel(int16_t channelIndex) : channelIndex(channelInd
   externalTrigger = TRIGGER_SOFTWARE;
   callback = nullptr;
   descriptorsLooped = false;
+  updating = false;
+  updateResume = false;
+  memset(&stats, 0, sizeof(stats));
 }
 
 
@@ -609,7 +1198,7 @@ bool TransferChannel::setDescriptors(TransferDescriptor **descriptorArray, int16
   int16_t prevWbIndex = getLastIndex();
 
   // Check nullptr exceptions
-  if (descriptorArray == nullptr) return false;
+  if (descriptorArray == nullptr || count <= 0 || count > DMA_MAX_CHAIN_LENGTH) return false;
   for (int16_t i = 0; i < count; i++) {
     if (descriptorArray[i] == nullptr
     || (bindDescriptors && descriptorArray[i]->isBindable())) {
@@ -624,6 +1213,7 @@ bool TransferChannel::setDescriptors(TransferDescriptor **descriptorArray, int16
   memcpy(&primaryDescriptorArray[channelIndex], &descriptorArray[0]->desc, 
     sizeof(DmacDescriptor));
   currentDescriptor = &primaryDescriptorArray[channelIndex];
+  descriptorTable[0] = currentDescriptor;
 
   // Do we need to bind primary descriptor?
   if (bindDescriptors) {
@@ -636,17 +1226,27 @@ bool TransferChannel::setDescriptors(TransferDescriptor **descriptorArray, int16
     for (int16_t i = 1; i < count; i++) {
       DmacDescriptor *newDescriptor = nullptr;
 
-      // If binding descriptor -> dont alloc, otherwise -> alloc
+      // If binding descriptor -> dont alloc, otherwise -> alloc from pool
       if (bindDescriptors) {
         newDescriptor = descriptorArray[i]->bindLink();
       } else {
-        newDescriptor = new DmacDescriptor;
+        newDescriptor = DMAUtility::allocDescriptor(channelIndex);
+
+        // Pool exhausted -> give back what was taken so far
+        if (newDescriptor == nullptr) {
+          currentDescriptor->DESCADDR.bit.DESCADDR = 0;
+          descriptorCount = i;
+          clearDescriptors();
+          currentError = ERROR_DMA_DESCRIPTOR;
+          return false;
+        }
         memcpy(newDescriptor, &descriptorArray[i]->desc, sizeof(DmacDescriptor));
       }
 
       // Link descriptor to next one in array
       currentDescriptor->DESCADDR.bit.DESCADDR = (uint32_t)newDescriptor;
       currentDescriptor = newDescriptor;
+      descriptorTable[i] = newDescriptor;
 
       // If preserve writeback = true -> link writeback to new descriptor @ current index
       if (updateWriteback && i == prevWbIndex 
@@ -675,38 +1275,74 @@ bool TransferChannel::setDescriptor(TransferDescriptor *descriptor, bool bindDes
 }
 
 
+// Adopts a chain built in place (StaticChain) -> first is copied into the primary slot, the rest
+// are linked where they are. Nothing is allocated or validated, the pool ignores them on clear.
+bool TransferChannel::setDescriptorChain(DmacDescriptor *chain, int16_t count) {
+  if (chain == nullptr || count <= 0 || count > DMA_MAX_CHAIN_LENGTH) return false;
+  if (descriptorCount > 0) clearDescriptors();
+
+  memcpy(&primaryDescriptorArray[channelIndex], &chain[0], sizeof(DmacDescriptor));
+  DmacDescriptor *currentDescriptor = &primaryDescriptorArray[channelIndex];
+  descriptorTable[0] = currentDescriptor;
+
+  for (int16_t i = 1; i < count; i++) {
+    currentDescriptor->DESCADDR.bit.DESCADDR = (uint32_t)&chain[i];
+    currentDescriptor = &chain[i];
+    descriptorTable[i] = currentDescriptor;
+  }
+  currentDescriptor->DESCADDR.bit.DESCADDR = descriptorsLooped 
+    ? (uint32_t)&primaryDescriptorArray[channelIndex] : 0;
+  descriptorCount = count;
+  return true;
+}
+
+
 bool TransferChannel::replaceDescriptor(TransferDescriptor *updatedDescriptor, 
 int16_t descriptorIndex, bool bindDescriptor) {
 
   // Check for exceptions
-  CLAMP(descriptorIndex, 0, descriptorCount);
   if (descriptorCount == 0 || (bindDescriptor && updatedDescriptor->isBindable())) {
     return false;
   }
+  descriptorIndex = CLAMP(descriptorIndex, 0, descriptorCount - 1);
+
   // Handle cases -> descriptor is primary, or linked...
   if (descriptorIndex == 0) {
+    uint32_t primaryLink = primaryDescriptorArray[channelIndex].DESCADDR.bit.DESCADDR;
+
     // Unbind current descriptor
     if (boundPrimary != nullptr) {
       boundPrimary->unbindPrimary(&primaryDescriptorArray[channelIndex]);
       boundPrimary = nullptr;
     }
-    // Copy new descriptor into primary slot
+    // Copy new descriptor into primary slot, keep its link (chain/loop runs on through it)
     memcpy(&primaryDescriptorArray[channelIndex], &updatedDescriptor->desc,
       sizeof(DmacDescriptor));
+    primaryDescriptorArray[channelIndex].DESCADDR.bit.DESCADDR = primaryLink;
 
     // Bind the new primary descriptor (if applicable)
     if (bindDescriptor) {
       updatedDescriptor->bindPrimary(&primaryDescriptorArray[channelIndex]);
     }
   } else {
+    DmacDescriptor *previousDescriptor = getDescriptor(descriptorIndex - 1);
     DmacDescriptor *targetDescriptor = getDescriptor(descriptorIndex);
     uint32_t targetLink = targetDescriptor->DESCADDR.bit.DESCADDR;
 
-    // If binding -> delete target & replace it with updated descriptor (get link), 
+    // If binding -> free target & replace it with updated descriptor (get link), 
     //else -> copy into & overwrite current target with updated descriptor
     if (bindDescriptor) {
-      delete targetDescriptor;
+      uint32_t replacedAddr = (uint32_t)targetDescriptor;
+      DMAUtility::freeDescriptor(targetDescriptor, channelIndex);
       targetDescriptor = updatedDescriptor->bindLink();
+      previousDescriptor->DESCADDR.bit.DESCADDR = (uint32_t)targetDescriptor;
+      descriptorTable[descriptorIndex] = targetDescriptor;
+
+      // Writeback would fetch the old address next -> point it at the replacement
+      if (writebackDescriptorArray[channelIndex].DESCADDR.bit.DESCADDR == replacedAddr) {
+        writebackDescriptorArray[channelIndex].DESCADDR.bit.DESCADDR 
+          = (uint32_t)targetDescriptor;
+      }
     } else {
       memcpy(targetDescriptor, &updatedDescriptor->desc, sizeof(DmacDescriptor));
     }
@@ -731,11 +1367,14 @@ bool TransferChannel::addDescriptor(TransferDescriptor *descriptor, int16_t desc
   || bindDescriptor && !descriptor->isBindable()) {
     return false;
   }
+  if (descriptorCount >= DMA_MAX_CHAIN_LENGTH) {
+    currentError = ERROR_DMA_DESCRIPTOR;
+    return false;
+  }
  
   // If no descriptors in list call set descriptor
   if (descriptorCount == 0) {
-    setDescriptor(descriptor, bindDescriptor);
-    return true;
+    return setDescriptor(descriptor, bindDescriptor);
 
   // Handle case: descriptor added to primary position
   } else if (descriptorIndex == 0) {
@@ -751,9 +1390,13 @@ bool TransferChannel::addDescriptor(TransferDescriptor *descriptor, int16_t desc
       nextDescriptor = boundPrimary->bindLink();
       boundPrimary = nullptr;
     
-    // Else -> Copy prev primary into new allocated descriptor
+    // Else -> Copy prev primary into new pool descriptor
     } else {
-      nextDescriptor = new DmacDescriptor();
+      nextDescriptor = DMAUtility::allocDescriptor(channelIndex);
+      if (nextDescriptor == nullptr) {
+        currentError = ERROR_DMA_DESCRIPTOR;
+        return false;
+      }
       memcpy(nextDescriptor, &primaryDescriptorArray[channelIndex],
         sizeof(DmacDescriptor));
     }
@@ -770,7 +1413,12 @@ bool TransferChannel::addDescriptor(TransferDescriptor *descriptor, int16_t desc
     targetDescriptor = &primaryDescriptorArray[channelIndex];
 
     // Link (added) primary descriptor to prev primary descriptor
-    targetDescriptor->DESCADDR.bit.DESCADDR = (uint32_t)&nextDescriptor;
+    targetDescriptor->DESCADDR.bit.DESCADDR = (uint32_t)nextDescriptor;
+
+    // Shift table up, prev primary now lives @ index 1
+    memmove(&descriptorTable[2], &descriptorTable[1], 
+      (descriptorCount - 1) * sizeof(DmacDescriptor*));
+    descriptorTable[1] = nextDescriptor;
 
   // Handle case -> descriptor in middle of list or beyond end
   } else {
@@ -780,7 +1428,11 @@ bool TransferChannel::addDescriptor(TransferDescriptor *descriptor, int16_t desc
     if (bindDescriptor) {
       targetDescriptor = descriptor->bindLink();
     } else {
-      targetDescriptor = new DmacDescriptor();
+      targetDescriptor = DMAUtility::allocDescriptor(channelIndex);
+      if (targetDescriptor == nullptr) {
+        currentError = ERROR_DMA_DESCRIPTOR;
+        return false;
+      }
       memcpy(targetDescriptor, descriptor->currentDesc, sizeof(DmacDescriptor));
     }
 
@@ -796,6 +1448,11 @@ bool TransferChannel::addDescriptor(TransferDescriptor *descriptor, int16_t desc
     }
     // Link previous descriptor to target (added one)
     previousDescriptor->DESCADDR.bit.DESCADDR = (uint32_t)targetDescriptor;
+
+    // Shift table up from index & insert
+    memmove(&descriptorTable[descriptorIndex + 1], &descriptorTable[descriptorIndex], 
+      (descriptorCount - descriptorIndex) * sizeof(DmacDescriptor*));
+    descriptorTable[descriptorIndex] = targetDescriptor;
   } 
 
   // If wb linked to same descriptor as added one, it should be updated (if specified)
@@ -838,13 +1495,19 @@ bool TransferChannel::removeDescriptor(int16_t descriptorIndex, bool updateWrite
       boundPrimary->unbindPrimary(&primaryDescriptorArray[channelIndex]);
     }
 
-    // Move 2nd descriptor "down" by copying it into primary slot
+    // Move 2nd descriptor "down" by copying it into primary slot & give its slot back
     memcpy(&primaryDescriptorArray[channelIndex], nextDescriptor, 
       sizeof(DmacDescriptor));
+    DMAUtility::freeDescriptor(nextDescriptor, channelIndex);
+    nextDescriptor = &primaryDescriptorArray[channelIndex];
+
+    // 2nd descriptor now lives in primary slot -> drop its table entry
+    memmove(&descriptorTable[1], &descriptorTable[2], 
+      (descriptorCount - 2) * sizeof(DmacDescriptor*));
 
-    // If descriptors looped -> link last descriptor to new primary
+    // If descriptors looped -> link last descriptor to new primary (list is one shorter now)
     if (descriptorsLooped) {
-      previousDescriptor = getDescriptor(descriptorCount - 1);
+      previousDescriptor = getDescriptor(descriptorCount - 2);
       previousDescriptor->DESCADDR.bit.DESCADDR 
         = (uint32_t)&primaryDescriptorArray[channelIndex];
     }
@@ -865,15 +1528,17 @@ bool TransferChannel::removeDescriptor(int16_t descriptorIndex, bool updateWrite
 
     // Get prev, targ & next if removing descriptor in middle of list.
     } else {
-      previousDescriptor = getDescriptor(descriptorIndex);
+      previousDescriptor = getDescriptor(descriptorIndex - 1);
       targetDescriptor = (DmacDescriptor*)previousDescriptor->DESCADDR.bit.DESCADDR;
       nextDescriptor = (DmacDescriptor*)targetDescriptor->DESCADDR.bit.DESCADDR;
       removedAddr = (uint32_t)targetDescriptor;
     }
 
-    // Delete target descriptor
-    delete targetDescriptor;
+    // Give target descriptor back to pool & drop its table entry
+    DMAUtility::freeDescriptor(targetDescriptor, channelIndex);
     targetDescriptor = nullptr;
+    memmove(&descriptorTable[descriptorIndex], &descriptorTable[descriptorIndex + 1], 
+      (descriptorCount - descriptorIndex - 1) * sizeof(DmacDescriptor*));
 
     // If next descriptor is not nullptr -> link prev to it, else -> unlink prev
     if (nextDescriptor != nullptr) {
@@ -893,10 +1558,87 @@ bool TransferChannel::removeDescriptor(int16_t descriptorIndex, bool updateWrite
     }
   }
   descriptorCount--;
+  descriptorTable[descriptorCount] = nullptr;
+  return true;
+}
+
+
+// Note -> suspend lands after the ongoing burst (bounded by DMA_UPDATE_SPIN_LIMIT). The writeback
+// keeps the in flight block, so edits to the active descriptor apply from its next fetch.
+bool TransferChannel::beginUpdate() {
+  DMA_STATUS currentStatus = getStatus();
+  if (updating || currentStatus == DMA_CHANNEL_ERROR) {
+    currentError = ERROR_DMA_UPDATE;
+    return false;
+  }
+  updateResume = false;
+
+  // Disabled or already suspended -> DMAC is not fetching, nothing to wait for
+  if (currentStatus == DMA_CHANNEL_DISABLED || suspendFlag) {
+    updating = true;
+    return true;
+  }
+  // Hold suspend flag for polling -> keep it from the ISR (no callback for our own suspend)
+  DMAC->Channel[channelIndex].CHINTENCLR.reg = DMAC_CHINTENCLR_SUSP;
+  DMAC->Channel[channelIndex].CHCTRLB.bit.CMD = DMAC_CHCTRLB_CMD_SUSPEND_Val;
+
+  int16_t spins = 0;
+  while (!DMAC->Channel[channelIndex].CHINTFLAG.bit.SUSP) {
+    if (++spins >= DMA_UPDATE_SPIN_LIMIT) {
+      DMAC->Channel[channelIndex].CHCTRLB.bit.CMD = DMAC_CHCTRLB_CMD_RESUME_Val;
+      DMAC->Channel[channelIndex].CHINTENSET.reg = DMAC_CHINTENSET_SUSP;
+      currentError = ERROR_DMA_UPDATE;
+      return false;
+    }
+  }
+  DMAC->Channel[channelIndex].CHINTFLAG.reg = DMAC_CHINTFLAG_SUSP;
+  updateResume = true;
+  updating = true;
   return true;
 }
 
 
+bool TransferChannel::endUpdate() {
+  if (!updating) return false;
+
+  // Descriptors may have moved -> re-derive index the ISR reports from the writeback link
+  syncCurrentDescriptor();
+  updating = false;
+
+  if (updateResume) {
+    updateResume = false;
+    DMAC->Channel[channelIndex].CHINTFLAG.reg = DMAC_CHINTFLAG_SUSP;
+    DMAC->Channel[channelIndex].CHINTENSET.reg = DMAC_CHINTENSET_SUSP;
+    DMAC->Channel[channelIndex].CHCTRLB.bit.CMD = DMAC_CHCTRLB_CMD_RESUME_Val;
+  }
+  return true;
+}
+
+
+bool TransferChannel::isUpdating() { return updating; }
+
+
+// Replaces descriptor on a running channel w interrupts masked -> suspend window is only the copy
+bool TransferChannel::updateDescriptor(TransferDescriptor *updatedDescriptor, 
+  int16_t descriptorIndex) {
+  if (updatedDescriptor == nullptr || descriptorIndex < 0 
+  || descriptorIndex >= descriptorCount) {
+    currentError = ERROR_SETTINGS_OOB;
+    return false;
+  }
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  bool result = beginUpdate();
+  if (result) {
+    result = replaceDescriptor(updatedDescriptor, descriptorIndex, false);
+    endUpdate();
+  }
+  if (!primask) __enable_irq();
+  return result;
+}
+
+
 bool TransferChannel::trigger() {
   // Check for exceptions
   if (isPending()
@@ -982,8 +1724,10 @@ bool TransferChannel::queue(int16_t descriptorIndex) {
 }
 
 
+// Note -> also ends a suspend (disabled channel restarts from the first descriptor)
 void TransferChannel::disable(bool blocking) {
   syncStatus = 0;
+  suspendFlag = false;
   DMAC->Channel[channelIndex].CHCTRLA.bit.ENABLE = 0;
   if (blocking) {
     while(DMAC->Channel[channelIndex].CHCTRLA.bit.ENABLE);
@@ -1020,7 +1764,7 @@ bool TransferChannel::disableExternalTrigger() {
 
 bool TransferChannel::setDescriptorValid(int16_t descriptorIndex, bool valid) {
   // Check for exceptions
-  CLAMP(descriptorIndex, -1, descriptorCount);
+  CLAMP(descriptorIndex, -1, descriptorCount - 1);
   if (descriptorCount == 0
   || (descriptorIndex == -1 && writebackDescriptorArray[channelIndex].SRCADDR.reg
    | DMAC_SRCADDR_RESETVALUE == 0)) {
@@ -1039,18 +1783,25 @@ bool TransferChannel::setDescriptorValid(int16_t descriptorIndex, bool valid) {
 } 
 
 
+// In place -> takes effect the next time the DMAC fetches the descriptor (not the active one)
+bool TransferChannel::setDescriptorAction(int16_t descriptorIndex, DMA_TRANSFER_ACTION action) {
+  DmacDescriptor *desc = getDescriptor(descriptorIndex);
+  if (desc == nullptr) return false;
+  desc->BTCTRL.bit.BLOCKACT = (uint8_t)action;
+  return true;
+}
+
+
 bool TransferChannel::setAllValid(bool valid) {
   // Check for exceptions
   if (descriptorCount == 0) {
     return false;
   }
   // Iterate through all descriptors and if valid does not match update valid status
-  DmacDescriptor *targetDescriptor = &primaryDescriptorArray[channelIndex]; 
-  for (int16_t i = 1; i <= descriptorCount; i++) {
-    if (targetDescriptor->BTCTRL.bit.VALID != (uint8_t)valid) {
-      targetDescriptor->BTCTRL.bit.VALID = (uint8_t)valid;
+  for (int16_t i = 0; i < descriptorCount; i++) {
+    if (descriptorTable[i]->BTCTRL.bit.VALID != (uint8_t)valid) {
+      descriptorTable[i]->BTCTRL.bit.VALID = (uint8_t)valid;
     }
-    targetDescriptor = (DmacDescriptor*)targetDescriptor->DESCADDR.bit.DESCADDR;
   }
   return true;
 }
@@ -1058,7 +1809,7 @@ bool TransferChannel::setAllValid(bool valid) {
 
 bool TransferChannel::getDescriptorValid(int16_t descriptorIndex) {
   // Check for exceptions
-  CLAMP(descriptorIndex, -1, descriptorCount);
+  CLAMP(descriptorIndex, -1, descriptorCount - 1);
   if (primaryDescriptorArray[channelIndex].SRCADDR.reg | DMAC_SRCADDR_RESETVALUE == 0
   && (descriptorIndex == -1 && writebackDescriptorArray[channelIndex].SRCADDR.reg
    | DMAC_SRCADDR_RESETVALUE == 0)) {
@@ -1141,6 +1892,43 @@ return ((DMAC->Channel[channelIndex].CHSTATUS.bit.BUSY
 }
 
 
+// Descriptor the DMAC is working through, from the writeback link -> holds w/out block
+// interrupts (unlike getLastIndex). Only current while the channel is not mid burst.
+int16_t TransferChannel::getActiveIndex() {
+  if (descriptorCount == 0 || writebackDescriptorArray[channelIndex].SRCADDR.bit.SRCADDR == 0) {
+    return -1;
+  }
+  uint32_t next = writebackDescriptorArray[channelIndex].DESCADDR.bit.DESCADDR;
+  if (next == 0) return descriptorCount - 1;
+
+  for (int16_t i = 0; i < descriptorCount; i++) {
+    if ((uint32_t)descriptorTable[i] == next) {
+      return (i == 0) ? descriptorCount - 1 : i - 1;
+    }
+  }
+  return -1;
+}
+
+
+// Looped list -> oldest block the DMAC finished that cursor has not been past yet (-1 if none)
+// & moves cursor on by one. Read from the writeback, so a late ISR or one TCMPL for several
+// blocks still hands out every block, once & in order (call until -1).
+// Note -> cursor starts @ 0, a full lap between calls looks like no progress
+int16_t TransferChannel::nextCompleted(int16_t &cursor) {
+  int16_t active = getActiveIndex();
+  if (active == -1 || cursor < 0 || cursor >= descriptorCount) return -1;
+
+  // Next descriptor not fetched yet -> writeback still holds the block that just finished
+  int16_t limit = active;
+  if (writebackDescriptorArray[channelIndex].BTCNT.bit.BTCNT == 0) {
+    limit = (active + 1) % descriptorCount;
+  }
+  if (cursor == limit) return -1;
+  int16_t index = cursor;
+  cursor = (cursor + 1) % descriptorCount;
+  return index;
+}
+
 int16_t TransferChannel::getLastIndex() {
   if (getStatus() == DMA_CHANNEL_BUSY) {
     if (currentDescriptor + 1 == descriptorCount) {
@@ -1232,20 +2020,40 @@ int16_t TransferChannel::setOwnerID(int16_t newOwnerID) {
 
 uint8_t TransferChannel::getChannelNum() { return channelIndex; }
 
+ERROR_ID TransferChannel::getError() { return currentError; }
 
-DmacDescriptor *TransferChannel::getDescriptor(int16_t descriptorIndex) {
-  // If target descriptor cached -> use that one
-  if (previousIndex == descriptorIndex) return previousDescriptor;
+bool TransferChannel::isAllocated() { return allocated; }
 
-  // Else iterate through descriptors until at specified index
-  DmacDescriptor *currentDescriptor = &primaryDescriptorArray[channelIndex];
-  for (int16_t i = 1; i <= descriptorIndex; i++) {
-    currentDescriptor = (DmacDescriptor*)currentDescriptor->DESCADDR.bit.DESCADDR;
-  } 
-  // Save descriptor & index to cache
-  previousDescriptor = currentDescriptor;
-  previousIndex = descriptorIndex;
-  return currentDescriptor;
+// Safe to call from DMA callbacks -> constant time, nullptr if index out of range
+const DmacDescriptor *TransferChannel::descriptor(int16_t descriptorIndex) {
+  return getDescriptor(descriptorIndex);
+}
+
+int16_t TransferChannel::getDescriptorCount() { return descriptorCount; }
+
+bool TransferChannel::getStats(DMAChannelStats &snapshot) {
+  if (!DMA_STATS_ENABLED) return false;
+
+  // Copy w interrupts masked -> counters are consistent w each other
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  snapshot = stats;
+  if (!primask) __enable_irq();
+  return true;
+}
+
+void TransferChannel::clearStats() {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  memset(&stats, 0, sizeof(stats));
+  if (!primask) __enable_irq();
+}
+
+
+// Note -> table is kept in chain order by set/add/remove/replace, so no list walk is needed
+DmacDescriptor *TransferChannel::getDescriptor(int16_t descriptorIndex) {
+  if (descriptorIndex < 0 || descriptorIndex >= descriptorCount) return nullptr;
+  return descriptorTable[descriptorIndex];
 }
 
 
@@ -1265,12 +2073,16 @@ void TransferChannel::init(int16_t ownerID) {
   currentDescriptor = 0;
   descriptorCount = 0;
   externalTriggerEnabled = false;
-  previousDescriptor = nullptr;
+  memset(descriptorTable, 0, sizeof(descriptorTable));
   syncStatus = 0;
+  updating = false;
+  updateResume = false;
+  memset(&stats, 0, sizeof(stats));
 
   this->ownerID = ownerID;
 
-  // Enable all interrupts
+  // Register in dispatch table & enable all interrupts
+  setDispatch(channelIndex, channelISR);
   DMAC->Channel[channelIndex].CHINTENSET.reg |= DMAC_CHINTENSET_MASK;
 }
 
@@ -1282,30 +2094,39 @@ void TransferChannel::clearDescriptors() {
     boundPrimary->unbindPrimary(&primaryDescriptorArray[channelIndex]);
     boundPrimary = nullptr;
   }
-
-  if (descriptorCount > 1) {
-
-    // Get descriptor linked to primary & clear primary using memset
-    DmacDescriptor *currentDescriptor 
-      = (DmacDescriptor*)primaryDescriptorArray[channelIndex].DESCADDR.bit.DESCADDR;
+  // Give linked pool descriptors back (bound ones are ignored by the pool)
+  for (int16_t i = 1; i < descriptorCount; i++) {
+    DMAUtility::freeDescriptor(descriptorTable[i], channelIndex);
+  }
+  if (descriptorCount > 0) {
     memset(&primaryDescriptorArray[channelIndex], 0, sizeof(DmacDescriptor));
+  }
+  memset(descriptorTable, 0, sizeof(descriptorTable));
+  descriptorCount = 0;
+}
+
 
-    // If applicable -> iterate through linked descriptors & delete them
-    for (int16_t i = 0; i < descriptorCount - 1; i++) {
-      DmacDescriptor *nextDescriptor
-        = (DmacDescriptor*)primaryDescriptorArray[channelIndex].DESCADDR.bit.DESCADDR;
+void TransferChannel::syncCurrentDescriptor() {
+  uint32_t nextAddr = writebackDescriptorArray[channelIndex].DESCADDR.bit.DESCADDR;
 
-      delete currentDescriptor;
-      currentDescriptor = nextDescriptor;
+  // Channel never ran or list is empty -> nothing to track
+  if (descriptorCount == 0 
+  || (writebackDescriptorArray[channelIndex].SRCADDR.bit.SRCADDR | DMAC_SRCADDR_RESETVALUE)
+    == DMAC_SRCADDR_RESETVALUE) {
+    currentDescriptor = 0;
+    return;
+  }
+  // No link -> on last descriptor
+  if (nextAddr == 0) {
+    currentDescriptor = descriptorCount - 1;
+    return;
+  }
+  for (int16_t i = 0; i < descriptorCount; i++) {
+    if ((uint32_t)descriptorTable[i] == nextAddr) {
+      currentDescriptor = (i == 0) ? descriptorCount - 1 : i - 1;
+      return;
     }
-    delete currentDescriptor;
-    currentDescriptor = nullptr;
-  
-  // No linked descriptors -> just delete primary...
-  } else if (descriptorCount == 1) {
-    memset(&primaryDescriptorArray[channelIndex], 0, sizeof(DmacDescriptor));
   }
-  descriptorCount = 0;
 }
 
 
@@ -1313,7 +2134,9 @@ void TransferChannel::loopDescriptors(bool updateWriteback) {
   DmacDescriptor *lastDescriptor = getDescriptor(descriptorCount - 1);
 
   // Is last descriptor already looped? -> If not link last -> primary (first)
-  if (!descriptorsLooped) {
+  if (lastDescriptor == nullptr) {
+    descriptorsLooped = true;
+  } else if (!descriptorsLooped) {
     descriptorsLooped = true;
 
     // Link last descriptor
@@ -1334,7 +2157,9 @@ void TransferChannel::unloopDescriptors(bool updateWriteback) {
   DmacDescriptor *lastDescriptor = getDescriptor(descriptorCount - 1);
 
     // Ensure last descriptor looped before unlooping
-  if (descriptorsLooped) {
+  if (lastDescriptor == nullptr) {
+    descriptorsLooped = false;
+  } else if (descriptorsLooped) {
     descriptorsLooped = false;
 
     // Unlink last descriptor
@@ -1355,101 +2180,196 @@ void TransferChannel::unloopDescriptors(bool updateWriteback) {
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 static ChecksumGen *chksumArray[DMA_MAX_CHECKSUM] = { nullptr };
+ChecksumGen *ChecksumGen::engineOwner = nullptr;
 
 void ChecksumIRQHandler(DMA_CALLBACK_REASON reason, TransferChannel &source, 
 int16_t descriptorIndex) {
+  if (source.getOwnerID() < 0 || source.getOwnerID() >= DMA_MAX_CHECKSUM) return;
   ChecksumGen *chksum = chksumArray[source.getOwnerID()];
-  if (chksum == nullptr) return;
-
-  // Decrement cycle counter
-  if (reason == REASON_TRANSFER_COMPLETE_STOPPED) {
-    chksum->remainingCycles--;
+  if (chksum == nullptr || !chksum->busy) return;
+
+  // Whole block went through the engine -> read & finalize result like the software reference
+  ERROR_ID error = source.getError();
+  if (reason == REASON_TRANSFER_COMPLETE_STOPPED && error == ERROR_NONE) {
+    uint32_t raw = DMAC->CRCCHKSUM.reg;
+    chksum->checksum = chksum->mode32 ? softCRC32Final(raw) : (raw & 0xFFFF);
+  } else if (error == ERROR_NONE) {
+    return;
   }
-
-  // If finished or error -> call callback, else -> trigger
-  if (chksum->remainingCycles <= 0 || source.getError()) {
-    int16_t remainingByteCount = chksum->remainingBytes();
-    chksum->remainingCycles = 0;
-    (*chksum->callback)(source.getError(), remainingByteCount);
-    
-  } else {
-    DMAC->SWTRIGCTRL.reg |= (1 << source.channelIndex);
+  chksum->release();
+  if (chksum->callback != nullptr) {
+    chksum->callback(*chksum, error, chksum->checksum);
   }
 }
                                                                                           
-ChecksumGen::ChecksumGen(int16_t ownerID) :
-  readDesc(nullptr, nullptr, 0), writeDesc(nullptr, nullptr, 0), ownerID(ownerID) {       
+ChecksumGen::ChecksumGen(int16_t ownerID) : ownerID(ownerID) {       
+  channel = nullptr;
+  callback = nullptr;
+  uniqueID = -1;
+  sourceAddr = 0;
+  destAddr = 0;
+  sink = 0;
+  busy = false;
+  checksum = 0;
+  mode32 = CHECKSUM_DEFAULT_CHECKSUM32;
+
   for (int16_t i = 0; i < DMA_MAX_CHECKSUM; i++) {
     if (chksumArray[i] == nullptr) {
-      chksumArray[i] == this;
+      chksumArray[i] = this;
       uniqueID = i;
+      break;
     }
   }
-  channel = DMA.allocateChannel(uniqueID);                                               
 }
 
+// Note -> call after DMA.begin()
+bool ChecksumGen::begin() {
+  if (channel != nullptr) return true;
+  if (uniqueID == -1) return false;
 
-void ChecksumGen::init() {
-  // init fields & settings
-  remainingCycles = 0;
-  settings.setDefault();
-  
-  // init read & write transfer descriptors & loop them
-  TransferDescriptor *descList[2] = { &writeDesc, &readDesc };
-  channel->setDescriptors(descList, 2, true, false);
+  DMAChannelRequest request = { uniqueID, SUBSYSTEM_CHECKSUM, CLASS_BACKGROUND, 
+    TRIGGER_SOFTWARE, 0, false, false };
+  channel = DMAUtility::allocateChannel(request);
+  if (channel == nullptr) return false;
+  init();
+  return true;
+}
+
+bool ChecksumGen::start(const void *data, uint32_t length) {
+  if (busy || length > INT16_MAX) return false;
+  settings.setSource((void*)data, false);
+  return start(length);
 }
 
 bool ChecksumGen::start(int16_t checksumLength) {
-  // Handle different states & exceptions
-  DMA_STATUS currentStatus = channel->getStatus();
-  if (currentStatus == DMA_CHANNEL_BUSY
-  || currentStatus == DMA_CHANNEL_ERROR
-  || checksumLength % (2 * ((int16_t)mode32 + 1)) != 0) {
-    return false;
+  if (channel == nullptr || busy || sourceAddr == 0 || checksumLength <= 0) return false;
 
-  // If suspended -> unsuspend:
-  } else if (currentStatus == DMA_CHANNEL_SUSPENDED) {
-    channel->resume();
-    return true;
+  // Widest beat the data allows (CRC16 engine consumes MSB first -> byte beats keep byte order)
+  int16_t beatSize = 1;
+  if (mode32 && checksumLength % 4 == 0 && sourceAddr % 4 == 0 && destAddr % 4 == 0) {
+    beatSize = 4;
   }
-  // Calculate remaining transfer cycles depending on mode
-  remainingCycles = checksumLength / (2 * ((int16_t)mode32 + 1));
-  writeDesc.setTransferAmount(checksumLength);
-  readDesc.setTransferAmount(checksumLength);
-
-  // If descriptors valid -> trigger transfer
-  if (writeDesc.isValid() && readDesc.isValid()) {
-    channel->trigger();
-    return true;
-  } else {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (engineOwner != nullptr) {
+    if (!primask) __enable_irq();
     return false;
   }
+  engineOwner = this;
+  busy = true;
+  if (!primask) __enable_irq();
+
+  // Source -> engine -> destination (or sink when only the checksum is wanted)
+  desc.setDataSize(beatSize)
+    .setIncrementConfig(true, destAddr != 0)
+    .setTransferAmount(checksumLength / beatSize) // Beats
+    .setAction(ACTION_BLOCK_INTERRUPT)
+    .setSource(sourceAddr, true)
+    .setDestination(destAddr != 0 ? destAddr : (uint32_t)&sink, destAddr != 0);
+  channel->setDescriptor(&desc, false);
+  channel->enable();
+
+  // Engine must be disabled (CRCSRC = 0) while being re-configured
+  DMAC->CRCCTRL.reg = 0;
+  DMAC->CRCSTATUS.reg = DMAC_CRCSTATUS_CRCBUSY;
+  DMAC->CRCCHKSUM.reg = mode32 ? CHECKSUM_CRC32_INIT : CHECKSUM_CRC16_INIT;
+  DMAC->CRCCTRL.reg = DMAC_CRCCTRL_CRCBEATSIZE(beatSize >> 1)
+    | DMAC_CRCCTRL_CRCPOLY(mode32 ? DMAC_CRCCTRL_CRCPOLY_CRC32_Val : DMAC_CRCCTRL_CRCPOLY_CRC16_Val)
+    | DMAC_CRCCTRL_CRCSRC(CHECKSUM_CRCSRC_CHANNEL + channel->channelIndex);
+
+  if (!channel->trigger()) {
+    release();
+    return false;
+  }
+  return true;
 }
 
 bool ChecksumGen::stop(bool hardStop) {
-  DMA_STATUS currentStatus = channel->getStatus();
-  if (currentStatus != DMA_CHANNEL_BUSY) {
-    return !(currentStatus == DMA_CHANNEL_ERROR);
+  if (!busy) return true;
+
+  // If hard stop -> reset transfer & free engine, else -> suspend transfer
+  if (hardStop) {
+    channel->resetTransfer(false);
+    release();
   } else {
+    channel->suspend(false);
+  }
+  return true;
+}
 
-    // If hard stop -> reset transfer, else -> suspend transfer
-    if (hardStop) {
-      channel->resetTransfer(false);
-      remainingCycles = 0;
-    } else {
-      channel->suspend(false);
+bool ChecksumGen::isBusy() { return busy; }
+
+uint32_t ChecksumGen::getChecksum() { return checksum; }
+
+// Runs hw engine over a test vector in both modes & compares against the software reference
+bool ChecksumGen::selfTest() {
+  static __attribute__((__aligned__(4))) uint8_t vector[CHECKSUM_TEST_LENGTH];
+  for (int16_t i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+    vector[i] = (uint8_t)(i * 37 + 11);
+  }
+  bool prevMode = mode32;
+  uint32_t prevSource = sourceAddr;
+  uint32_t prevDest = destAddr;
+  ChecksumCallback prevCB = callback;
+  callback = nullptr;
+  destAddr = 0;
+  bool passed = true;
+
+  for (int16_t m = 0; m < 2 && passed; m++) {
+    mode32 = (bool)m;
+    if (!start(vector, CHECKSUM_TEST_LENGTH)) {
+      passed = false;
+      break;
     }
-    return true;
+    uint32_t start = micros();
+    while (busy && micros() - start < CHECKSUM_TEST_TIMEOUT);
+    bool timedOut = busy;
+    if (busy) stop(true);
+
+    uint32_t expected = mode32 
+      ? softCRC32Final(softCRC32(vector, CHECKSUM_TEST_LENGTH))
+      : softCRC16(vector, CHECKSUM_TEST_LENGTH);
+    passed = !timedOut && checksum == expected;
   }
+  if (!passed && channel != nullptr) channel->currentError = ERROR_DMA_CRC;
+
+  // Restore settings
+  mode32 = prevMode;
+  sourceAddr = prevSource;
+  destAddr = prevDest;
+  callback = prevCB;
+  return passed;
 }
 
-bool ChecksumGen::isBusy() { return !(channel->syncBusy() || isBusy()); }
+int16_t ChecksumGen::remainingBytes() { 
+  return (channel == nullptr) ? 0 : channel->remainingBytes(); 
+}
+
+ERROR_ID ChecksumGen::getError() { 
+  return (channel == nullptr) ? ERROR_NULLPTR : channel->getError(); 
+}
 
-int16_t ChecksumGen::remainingBytes() { return channel->remainingBytes(); }
+ChecksumGen::~ChecksumGen() { 
+  stop(true);
+  if (channel != nullptr) DMA.freeChannel(channel); 
+  if (uniqueID != -1) chksumArray[uniqueID] = nullptr;
+}
 
-ERROR_ID ChecksumGen::getError() { return channel->getError(); }
+void ChecksumGen::init() {
+  busy = false;
+  checksum = 0;
+  settings.setDefault();
+}
 
-ChecksumGen::~ChecksumGen() { DMA.freeChannel(channel); }
+// Note -> call from ISR or with interrupts masked
+void ChecksumGen::release() {
+  if (engineOwner == this) {
+    DMAC->CRCCTRL.reg = 0;
+    DMAC->CRCSTATUS.reg = DMAC_CRCSTATUS_CRCBUSY;
+    engineOwner = nullptr;
+  }
+  busy = false;
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> CHECKSUM CHANNEL SETTINGS
@@ -1461,81 +2381,92 @@ ChecksumGen::ChecksumSettings::ChecksumSettings(ChecksumGen *super) {
 
 ChecksumGen::ChecksumSettings &ChecksumGen::ChecksumSettings::setSource(void *sourcePtr,
   bool correctAddress) {
-  super->writeDesc.setSource(sourcePtr, correctAddress = true);
-  return *this;
+  return setSource((uint32_t)sourcePtr, correctAddress);
 }
 
+// Note -> addresses are base addresses, end address correction is done on start()
 ChecksumGen::ChecksumSettings &ChecksumGen::ChecksumSettings::setSource(
   uint32_t sourceAddress, bool correctAddress) {
-  super->writeDesc.setSource(sourceAddress, correctAddress);
+  super->sourceAddr = sourceAddress;
   return *this;
 }
 
 ChecksumGen::ChecksumSettings &ChecksumGen::ChecksumSettings::setDestination(
   void *destinationPtr, bool correctAddress) {
-  super->writeDesc.setDestination(destinationPtr, correctAddress);
-  return *this;
+  return setDestination((uint32_t)destinationPtr, correctAddress);
 }
 
 ChecksumGen::ChecksumSettings &ChecksumGen::ChecksumSettings::setDestination(
   uint32_t destinationAddress, bool correctAddress) {
-  super->writeDesc.setDestination(destinationAddress, correctAddress);
+  super->destAddr = destinationAddress;
   return *this;
 }
 
 ChecksumGen::ChecksumSettings &ChecksumGen::ChecksumSettings::setCRC(CRC_MODE mode) {
-  if ((uint8_t)mode == super->mode32) return *this;
-  super->mode32 = (bool)mode; 
+  if (super->busy) return *this;
+  super->mode32 = (mode == CRC_32); 
   return *this;
 }
 
 ChecksumGen::ChecksumSettings &ChecksumGen::ChecksumSettings::setStandbyConfig(bool enabledDurringStandby) {
-  super->channel->settings.setStandbyConfig(enabledDurringStandby);
+  if (super->channel != nullptr) {
+    super->channel->settings.setStandbyConfig(enabledDurringStandby);
+  }
   return *this;
 }
 
-ChecksumGen::ChecksumSettings &ChecksumGen::ChecksumSettings::setCallbackFunction(ChecksumCallback *callbackFunc) {
+ChecksumGen::ChecksumSettings &ChecksumGen::ChecksumSettings::setCallbackFunction(ChecksumCallback callbackFunc) {
   super->callback = callbackFunc;
   return *this;
 }
 
 ChecksumGen::ChecksumSettings &ChecksumGen::ChecksumSettings::setPriorityLevel(int16_t priorityLvl) {
-  super->channel->settings.setPriorityLevel(priorityLvl);
+  if (super->channel != nullptr) {
+    super->channel->settings.setPriorityLevel(priorityLvl);
+  }
   return *this;
 }
 
 void ChecksumGen::ChecksumSettings::setDefault() {
-
-  // Configure default write descriptor settings
-  super->writeDesc.setDataSize(CHECKSUM_DEFAULT_DATASIZE)
-    .setAction(CHECKSUM_WRITEDESC_DEFAULT_TRANSFER_ACTION)
-    .setTransferAmount(CHECKSUM_DEFAULT_TRANSFER_AMOUNT)
-    .setDestination((uint32_t)&CHECKSUM_WRITEDESC_REQUIRED_DESTINATION,
-       CHECKSUM_WRITEDESC_REQUIRED_CORRECT_DESTADDR)
-    .setIncrementConfig(CHECKSUM_REQUIRED_INCREMENT_CONFIG_SOURCE,
-       CHECKSUM_REQUIRED_INCREMENT_CONFIG_DESTINATION);
-
-  // Configure default read descriptor settings
-  super->readDesc.setDataSize(CHECKSUM_DEFAULT_DATASIZE)
-    .setAction(CHECKSUM_READDESC_DEFAULT_TRANSFER_ACTION)
-    .setTransferAmount(CHECKSUM_DEFAULT_TRANSFER_AMOUNT)
-    .setSource((uint32_t)&CHECKSUM_READDESC_REQUIRED_SOURCE,
-       CHECKSUM_READDESC_REQUIRED_CORRECT_SOURCEADDR)
-    .setIncrementConfig(CHECKSUM_REQUIRED_INCREMENT_CONFIG_SOURCE,
-       CHECKSUM_REQUIRED_INCREMENT_CONFIG_DESTINATION);
-
-  // Reset settings variables
   super->callback = nullptr;
   super->mode32 = CHECKSUM_DEFAULT_CHECKSUM32;
+  super->sourceAddr = 0;
+  super->destAddr = 0;
+  if (super->channel == nullptr) return;
 
   // Set default base settings
   super->channel->settings.setDefault();
-  super->channel->settings.setDescriptorsLooped(true, false);
+  super->channel->settings.setStandbyConfig(CHECKSUM_DEFAULT_SLEEPCONFIG);
+  super->channel->settings.setPriorityLevel(CHECKSUM_DEFAULT_PRIORITY_LVL);
   super->channel->settings.setCallbackConfig(true, true, false);
   super->channel->settings.setCallbackFunction(ChecksumIRQHandler);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> SOFTWARE CHECKSUM
+///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Note -> crc arg allows continuing over split data, finalize CRC32 w softCRC32Final()
+uint16_t softCRC16(const void *data, uint32_t length, uint16_t crc) {
+  const uint8_t *bytes = (const uint8_t*)data;
+  for (uint32_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)bytes[i] << 8;
+    for (int16_t b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ CHECKSUM_CRC16_POLY : (crc << 1);
+    }
+  }
+  return crc;
+}
 
+uint32_t softCRC32(const void *data, uint32_t length, uint32_t crc) {
+  const uint8_t *bytes = (const uint8_t*)data;
+  for (uint32_t i = 0; i < length; i++) {
+    crc ^= bytes[i];
+    for (int16_t b = 0; b < 8; b++) {
+      crc = (crc & 1) ? (crc >> 1) ^ CHECKSUM_CRC32_POLY : (crc >> 1);
+    }
+  }
+  return crc;
+}
 
-
+uint32_t softCRC32Final(uint32_t crc) { return crc ^ CHECKSUM_CRC32_XOROUT; }
@@ -0,0 +1,239 @@
+
+#include <FRAME.h>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> FRAME ENCODER
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+FrameEncoder::FrameEncoder(uint8_t streamID, CRC_MODE mode) : streamID(streamID) {
+  memset(slots, 0, sizeof(slots));
+  slotIndex = 0;
+  sequence = 0;
+  crcMode = mode;
+  currentError = ERROR_NONE;
+}
+
+// Note -> payload must be word aligned, a multiple of 4 bytes & stay untouched until
+// releaseCallback
+bool FrameEncoder::send(void *payload, uint16_t payloadLength, COMSendCallback releaseCallback) {
+  if (payload == nullptr || payloadLength > FRAME_MAX_PAYLOAD) {
+    currentError = ERROR_SETTINGS_INVALID;
+    return false;
+  }
+  return sendWithCRC(payload, payloadLength, payloadCRC(payload, payloadLength), releaseCallback);
+}
+
+// Note -> payloadCRC must be computed in the encoder's CRC mode (e.g. by ChecksumGen)
+bool FrameEncoder::sendWithCRC(void *payload, uint16_t payloadLength, uint32_t payloadCRC,
+  COMSendCallback releaseCallback) {
+  if (payload == nullptr || payloadLength == 0 || payloadLength > FRAME_MAX_PAYLOAD
+  || payloadLength % 4 != 0) {
+    currentError = ERROR_SETTINGS_INVALID;
+    return false;
+  }
+  FrameSlot &slot = slots[slotIndex];
+  writeHeader(slot.header, payloadLength);
+  slot.trailer = payloadCRC;
+
+  // Sequence always advances -> frames dropped here show up as gaps on the host
+  sequence++;
+
+  const COMSendEntry entries[FRAME_SEND_ENTRIES] = {
+    { &slot.header, FRAME_HEADER_SIZE, nullptr, false },
+    { payload, payloadLength, releaseCallback, false },
+    { &slot.trailer, FRAME_TRAILER_SIZE, nullptr, true }
+  };
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // All entries or none -> a partial frame would cost the host a resync
+  if (!COMEnqueue(entries, FRAME_SEND_ENTRIES)) {
+    if (!primask) __enable_irq();
+    return false;
+  }
+  slotIndex = (slotIndex + 1) % FRAME_SLOT_COUNT;
+
+  if (!primask) __enable_irq();
+  return true;
+}
+
+int32_t FrameEncoder::encode(const void *payload, uint16_t payloadLength, uint8_t *dest,
+  uint32_t destSize) {
+  if (payload == nullptr || dest == nullptr || payloadLength > FRAME_MAX_PAYLOAD
+  || destSize < (uint32_t)payloadLength + FRAME_OVERHEAD) {
+    currentError = ERROR_SETTINGS_INVALID;
+    return -1;
+  }
+  FrameHeader header;
+  writeHeader(header, payloadLength);
+  uint32_t trailer = payloadCRC(payload, payloadLength);
+  sequence++;
+
+  // Copy out -> header, payload, trailer
+  memcpy(dest, &header, FRAME_HEADER_SIZE);
+  memcpy(dest + FRAME_HEADER_SIZE, payload, payloadLength);
+  memcpy(dest + FRAME_HEADER_SIZE + payloadLength, &trailer, FRAME_TRAILER_SIZE);
+  return payloadLength + FRAME_OVERHEAD;
+}
+
+void FrameEncoder::setCRC(CRC_MODE mode) { crcMode = mode; }
+
+CRC_MODE FrameEncoder::getCRC() { return crcMode; }
+
+uint32_t FrameEncoder::getSequence() { return sequence; }
+
+void FrameEncoder::resetSequence() { sequence = 0; }
+
+ERROR_ID FrameEncoder::getError() { return currentError; }
+
+void FrameEncoder::writeHeader(FrameHeader &header, uint16_t payloadLength) {
+  header.sync = FRAME_SYNC_WORD;
+  header.streamID = streamID;
+  header.flags = (crcMode == CRC_32) ? FRAME_FLAG_CRC32 : 0;
+  header.sequence = sequence;
+  header.timestamp = micros();
+  header.payloadLength = payloadLength;
+  header.headerCRC = softCRC16(&header, FRAME_HEADER_CRC_SPAN);
+}
+
+uint32_t FrameEncoder::payloadCRC(const void *payload, uint16_t payloadLength) {
+  if (crcMode == CRC_32) {
+    return softCRC32Final(softCRC32(payload, payloadLength));
+  }
+  return softCRC16(payload, payloadLength);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> FRAME DECODER
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Note -> buffer should fit at least one max size frame (FRAME_MAX_PAYLOAD + FRAME_OVERHEAD)
+FrameDecoder::FrameDecoder(uint8_t *buffer, uint32_t bufferSize) {
+  this->buffer = buffer;
+  this->bufferSize = (buffer == nullptr) ? 0 : bufferSize;
+  reset();
+}
+
+// Returns bytes taken -> call again w the rest once frames are consumed (next())
+uint32_t FrameDecoder::push(const void *data, uint32_t length) {
+  if (data == nullptr) return 0;
+  uint32_t count = MIN(length, bufferSize - fill);
+  memcpy(buffer + fill, data, count);
+  fill += count;
+  parse();
+  return count;
+}
+
+bool FrameDecoder::available() { return frameReady; }
+
+const FrameHeader *FrameDecoder::getHeader() {
+  return frameReady ? (const FrameHeader*)buffer : nullptr;
+}
+
+const uint8_t *FrameDecoder::getPayload() {
+  return frameReady ? buffer + FRAME_HEADER_SIZE : nullptr;
+}
+
+bool FrameDecoder::getPayloadValid() { return frameReady && payloadValid; }
+
+void FrameDecoder::next() {
+  if (!frameReady) return;
+  drop(frameBytes);
+  frameReady = false;
+  parse();
+}
+
+void FrameDecoder::reset() {
+  fill = 0;
+  frameBytes = 0;
+  frameReady = false;
+  payloadValid = false;
+  memset(lastSequence, 0, sizeof(lastSequence));
+  memset(streamSeen, 0, sizeof(streamSeen));
+  decodedCount = 0;
+  headerErrorCount = 0;
+  payloadErrorCount = 0;
+  gapCount = 0;
+  lostCount = 0;
+  skippedCount = 0;
+}
+
+uint32_t FrameDecoder::framesDecoded() { return decodedCount; }
+
+uint32_t FrameDecoder::headerErrors() { return headerErrorCount; }
+
+uint32_t FrameDecoder::payloadErrors() { return payloadErrorCount; }
+
+uint32_t FrameDecoder::sequenceGaps() { return gapCount; }
+
+uint32_t FrameDecoder::framesLost() { return lostCount; }
+
+uint32_t FrameDecoder::bytesSkipped() { return skippedCount; }
+
+void FrameDecoder::parse() {
+  const uint8_t syncLow = FRAME_SYNC_WORD & 0xFF;
+  const uint8_t syncHigh = FRAME_SYNC_WORD >> 8;
+
+  while (!frameReady && fill > 0) {
+
+    // Skip to sync word (keep a trailing low byte, high byte may still be coming)
+    uint32_t i = 0;
+    while (i + 1 < fill && !(buffer[i] == syncLow && buffer[i + 1] == syncHigh)) i++;
+    if (i + 1 >= fill && buffer[i] != syncLow) i = fill;
+    if (i > 0) {
+      skippedCount += i;
+      drop(i);
+    }
+    if (fill < FRAME_HEADER_SIZE) return;
+
+    // Check header -> on failure sync word was payload data, search again past it
+    FrameHeader header;
+    memcpy(&header, buffer, FRAME_HEADER_SIZE);
+    if (softCRC16(buffer, FRAME_HEADER_CRC_SPAN) != header.headerCRC
+    || (uint32_t)header.payloadLength + FRAME_OVERHEAD > bufferSize) {
+      headerErrorCount++;
+      skippedCount++;
+      drop(1);
+      continue;
+    }
+    frameBytes = header.payloadLength + FRAME_OVERHEAD;
+    if (fill < frameBytes) return;
+
+    // Check payload
+    uint32_t trailer;
+    memcpy(&trailer, buffer + FRAME_HEADER_SIZE + header.payloadLength, FRAME_TRAILER_SIZE);
+    uint32_t crc = (header.flags & FRAME_FLAG_CRC32)
+      ? softCRC32Final(softCRC32(buffer + FRAME_HEADER_SIZE, header.payloadLength))
+      : softCRC16(buffer + FRAME_HEADER_SIZE, header.payloadLength);
+    payloadValid = (crc == trailer);
+    if (!payloadValid) payloadErrorCount++;
+
+    // Header is intact -> sequence is trusted even if payload is not
+    trackSequence(header);
+    decodedCount++;
+    frameReady = true;
+  }
+}
+
+// Note -> reference implementation, memmove keeps it simple over fast
+void FrameDecoder::drop(uint32_t count) {
+  count = MIN(count, fill);
+  memmove(buffer, buffer + count, fill - count);
+  fill -= count;
+}
+
+void FrameDecoder::trackSequence(const FrameHeader &header) {
+  if (header.streamID >= FRAME_MAX_STREAMS) return;
+
+  if (streamSeen[header.streamID]) {
+    uint32_t gap = header.sequence - (lastSequence[header.streamID] + 1);
+    if (gap != 0) {
+      gapCount++;
+
+      // Sequence went backwards -> device restarted, nothing to count as lost
+      if (gap < 0x80000000ul) lostCount += gap;
+    }
+  }
+  lastSequence[header.streamID] = header.sequence;
+  streamSeen[header.streamID] = true;
+}
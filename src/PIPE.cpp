@@ -0,0 +1,258 @@
+
+#include <PIPE.h>
+
+static StreamPipe *activePipe = nullptr; // Only one USB IN endpoint -> one active pipe
+
+// DMA & USB interrupts can preempt each other -> guard shared block state
+static inline uint32_t enterCritical() {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  return primask;
+}
+
+static inline void exitCritical(uint32_t primask) {
+  if (!primask) __enable_irq();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> STREAM PIPE CALLBACKS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Called by ADC (DMA interrupt) when a stream block is full
+void pipeStreamCallback(ADCModule &source, uint16_t *block, int16_t sampleCount, 
+  int16_t blockIndex) {
+  StreamPipe *pipe = activePipe;
+  if (pipe == nullptr || pipe->source != &source) return;
+
+  // Split arrays are not the block -> never frame them (begin rejects split, this catches it
+  // being turned on later)
+  if (block != pipe->blockPtr[blockIndex]) {
+    pipe->droppedCount++;
+    return;
+  }
+  // Stop DMAC from overwriting the block until USB is done with it
+  uint32_t primask = enterCritical();
+  source.holdBlock(blockIndex);
+  exitCritical(primask);
+  pipe->checksumBlock(blockIndex);
+}
+
+// Called by CRC engine (DMA interrupt) when a block's checksum is ready
+void pipeCRCCallback(ChecksumGen &source, ERROR_ID error, uint32_t checksum) {
+  StreamPipe *pipe = activePipe;
+  if (pipe == nullptr) return;
+
+  // Take both CRC slots at once -> a block held meanwhile sees the engine idle
+  uint32_t primask = enterCritical();
+  int16_t done = pipe->crcBlock;
+  int16_t next = pipe->crcWaiting;
+  pipe->crcBlock = -1;
+  pipe->crcWaiting = -1;
+  exitCritical(primask);
+  if (done == -1) return;
+
+  // Engine failed -> drop block (never send a frame w a bad checksum)
+  if (error != ERROR_NONE) {
+    pipe->dropBlock(done);
+    pipe->currentError = error;
+  } else {
+    pipe->sendBlock(done, checksum);
+  }
+  // Start block that came in while engine was busy
+  if (next != -1) pipe->checksumBlock(next);
+}
+
+// Called by COM (USB interrupt) when the endpoint is done reading a block
+void pipeSendCallback(void *source) {
+  StreamPipe *pipe = activePipe;
+  if (pipe == nullptr) return;
+
+  // Recycle sent block
+  for (int16_t i = 0; i < ADC_STREAM_DESC_COUNT; i++) {
+    if (pipe->blockPtr[i] == source) {
+      uint32_t primask = enterCritical();
+      pipe->source->releaseBlock(i);
+      pipe->inFlight--;
+      pipe->sentCount++;
+      exitCritical(primask);
+      break;
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> STREAM PIPE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+StreamPipe::StreamPipe(uint8_t streamID) : framer(streamID), crc(PIPE_CHECKSUM_OWNER_ID) {
+  source = nullptr;
+  hwCRC = false;
+  resetFields();
+}
+
+// Note -> must be called after DMA.begin(), source->begin() & before source->enable()
+bool StreamPipe::begin(ADCModule *source, CRC_MODE mode) {
+  if (activePipe == this) return true;
+  if (activePipe != nullptr || source == nullptr) {
+    currentError = ERROR_NULLPTR;
+    return false;
+  }
+  // Split mode hands the callback per pin copies, the pipe sends & holds the blocks themselves
+  if (source->getSplitEnabled()) {
+    currentError = ERROR_SETTINGS_INVALID;
+    return false;
+  }
+  uint32_t blockBytes = (uint32_t)source->getBlockLength() * sizeof(uint16_t);
+
+  // Endpoint reads whole packets straight from the buffer -> blocks must be packet multiples
+  if (blockBytes % COM_PACKET_SIZE != 0 
+  || blockBytes / COM_PACKET_SIZE > COM_SEND_MAX_PACKETS) {
+    currentError = ERROR_SETTINGS_INVALID;
+    return false;
+  }
+  resetFields();
+  this->source = source;
+  blockPackets = blockBytes / COM_PACKET_SIZE;
+  for (int16_t i = 0; i < ADC_STREAM_DESC_COUNT; i++) {
+    blockPtr[i] = source->getBlock(i);
+  }
+
+  // Hw CRC only if engine agrees bit for bit w the software reference
+  hwCRC = crc.begin() && crc.selfTest();
+  crc.settings.setCRC(mode)
+    .setCallbackFunction(pipeCRCCallback);
+  framer.setCRC(mode);
+
+  source->settings.setStreamConfig(true, pipeStreamCallback);
+  activePipe = this;
+  return true;
+}
+
+void StreamPipe::end() {
+  if (activePipe != this) return;
+
+  // Give back any block still in the CRC engine or queued on the endpoint
+  crc.stop(true);
+  uint32_t primask = enterCritical();
+  if (crcBlock != -1) source->releaseBlock(crcBlock);
+  if (crcWaiting != -1) source->releaseBlock(crcWaiting);
+  crcBlock = -1;
+  crcWaiting = -1;
+  exitCritical(primask);
+  if (inFlight > 0) COM.abortSend();
+  activePipe = nullptr;
+
+  source->settings.setStreamConfig(false);
+  source = nullptr;
+  resetFields();
+}
+
+bool StreamPipe::isActive() { return activePipe == this; }
+
+uint32_t StreamPipe::blocksSent() { return sentCount; }
+
+uint32_t StreamPipe::blocksDropped() { return droppedCount; }
+
+bool StreamPipe::hardwareCRC() { return hwCRC; }
+
+ERROR_ID StreamPipe::getError() { return currentError; }
+
+StreamPipe::~StreamPipe() { end(); }
+
+void StreamPipe::resetFields() {
+  memset(blockPtr, 0, sizeof(blockPtr));
+  blockPackets = 0;
+  crcBlock = -1;
+  crcWaiting = -1;
+  inFlight = 0;
+  sentCount = 0;
+  droppedCount = 0;
+  currentError = ERROR_NONE;
+}
+
+// Note -> called from DMA interrupts, the USB interrupt may preempt -> CRC slots under PRIMASK
+void StreamPipe::checksumBlock(int16_t blockIndex) {
+  uint32_t blockBytes = blockPackets * COM_PACKET_SIZE;
+
+  // No engine -> software CRC in place
+  if (!hwCRC) {
+    uint32_t checksum = (framer.getCRC() == CRC_32)
+      ? softCRC32Final(softCRC32(blockPtr[blockIndex], blockBytes))
+      : softCRC16(blockPtr[blockIndex], blockBytes);
+    sendBlock(blockIndex, checksum);
+    return;
+  }
+  // Engine busy w previous block -> wait for its callback
+  uint32_t primask = enterCritical();
+  if (crcBlock != -1) {
+    bool waiting = (crcWaiting == -1);
+    if (waiting) crcWaiting = blockIndex;
+    exitCritical(primask);
+    if (!waiting) dropBlock(blockIndex);
+    return;
+  }
+  crcBlock = blockIndex;
+  bool started = crc.start(blockPtr[blockIndex], blockBytes);
+  if (!started) crcBlock = -1;
+  exitCritical(primask);
+
+  if (!started) {
+    dropBlock(blockIndex);
+    currentError = ERROR_DMA_CRC;
+  }
+}
+
+bool StreamPipe::sendBlock(int16_t blockIndex, uint32_t checksum) {
+  // Queue full -> drop block (backpressure), DMAC keeps going. Sequence still advances.
+  // Counted in flight first -> send callback may run before sendWithCRC returns
+  uint32_t primask = enterCritical();
+  inFlight++;
+  exitCritical(primask);
+  if (!framer.sendWithCRC(blockPtr[blockIndex], blockPackets * COM_PACKET_SIZE, checksum,
+    pipeSendCallback)) {
+    primask = enterCritical();
+    inFlight--;
+    exitCritical(primask);
+    dropBlock(blockIndex);
+    return false;
+  }
+  return true;
+}
+
+// Block will not be sent -> back to the DMAC
+void StreamPipe::dropBlock(int16_t blockIndex) {
+  uint32_t primask = enterCritical();
+  source->releaseBlock(blockIndex);
+  droppedCount++;
+  exitCritical(primask);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DMA STATS DUMP
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static FrameEncoder statsFramer(PIPE_STATS_STREAM_ID);
+static __attribute__((__aligned__(4))) DMAStatsRecord statsRecords[DMA_MAX_CHANNELS];
+static volatile bool statsInFlight = false;
+
+static void statsSendCallback(void *source) { statsInFlight = false; }
+
+bool sendDMAStats() {
+  if (statsInFlight) return false;
+
+  int16_t count = 0;
+  for (int16_t i = 0; i < DMA_MAX_CHANNELS; i++) {
+    if (DMAUtility::getStats(i, statsRecords[count].stats)) {
+      statsRecords[count].channelIndex = i;
+      count++;
+    }
+  }
+  if (count == 0) return false;
+
+  statsInFlight = true;
+  if (!statsFramer.send(statsRecords, count * sizeof(DMAStatsRecord), statsSendCallback)) {
+    statsInFlight = false;
+    return false;
+  }
+  return true;
+}
@@ -307,9 +307,17 @@ bool I2CBus::init() {
 bool I2CBus::initDMA() {
 
   // Allocate 2 new DMA channel
-  TransferChannel *newChannel1 = DMA.allocateChannel(SIOid);
-  TransferChannel *newChannel2 = DMA.allocateChannel(SIOid);
-  if (newChannel1 == nullptr || newChannel2 == nullptr) return false;
+  DMAChannelRequest readRequest = { SIOid, SUBSYSTEM_SIO, CLASS_NORMAL,
+    (DMA_TRIGGER)SERCOM_REF[sNum].DMAReadTrigger, 0, false, false };
+  DMAChannelRequest writeRequest = { SIOid, SUBSYSTEM_SIO, CLASS_NORMAL,
+    (DMA_TRIGGER)SERCOM_REF[sNum].DMAWriteTrigger, 0, false, false };
+  TransferChannel *newChannel1 = DMAUtility::allocateChannel(readRequest);
+  TransferChannel *newChannel2 = DMAUtility::allocateChannel(writeRequest);
+  if (newChannel1 == nullptr || newChannel2 == nullptr) {
+    DMA.freeChannel(newChannel1);
+    DMA.freeChannel(newChannel2);
+    return false;
+  }
 
   // Channels are not null -> set fields
   readChannel = newChannel1;
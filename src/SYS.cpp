@@ -1,6 +1,30 @@
 
 #include <SYS.h>
 
+System_ System_::instance;
+System_ &System = System_::instance;
+
+bool System_::EVNTUtil::channelUsed[EVNT_CHANNEL_COUNT] = { false };
+bool System_::EVNTUtil::begun = false;
+bool System_::TIMUtil::timerUsed[TIM_TIMER_COUNT] = { false };
+float System_::TIMUtil::timerRate[TIM_TIMER_COUNT] = { 0 };
+
+struct TimerInfo {
+  Tc *tc;
+  uint8_t clockID;
+  DMA_TRIGGER trigger;
+  uint8_t eventGenerator;
+};
+
+static TimerInfo TIMER_REF[TIM_TIMER_COUNT] {
+  {TC0, TC0_GCLK_ID, TRIGGER_TC0_OOB, EVSYS_ID_GEN_TC0_OVF},
+  {TC1, TC1_GCLK_ID, TRIGGER_TC1_OOB, EVSYS_ID_GEN_TC1_OVF},
+  {TC2, TC2_GCLK_ID, TRIGGER_TC2_OOB, EVSYS_ID_GEN_TC2_OVF},
+  {TC3, TC3_GCLK_ID, TRIGGER_TC3_OOB, EVSYS_ID_GEN_TC3_OVF}
+};
+
+static const uint16_t TIMER_PRESCALERS[] = { 1, 2, 4, 8, 16, 64, 256, 1024 }; // PRESCALER value
+
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///// SECTION -> CLOCK & OSCILLATOR UTILITY (CLK)
@@ -44,4 +68,237 @@ bool System_::CLKUtil::initialize() {
   while(GCLK->SYNCBUSY.reg & GCLK_SYNCBUSY_SWRST);
   
 
-}
\ No newline at end of file
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> EVENT UTILITY (EVNT)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Allocates an EVSYS channel & routes generator -> user. Returns the channel (-1 if none free).
+// Note -> async path needs no channel clock but can't detect edges, use resync/sync to filter
+int16_t System_::EVNTUtil::connect(uint8_t generatorID, uint8_t userID, EVENT_PATH path) {
+  if (generatorID == 0 || userID >= EVNT_USER_COUNT) return -1;
+  init();
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  int16_t found = -1;
+  for (int16_t i = 0; i < EVNT_CHANNEL_COUNT && found == -1; i++) {
+    if (!channelUsed[i]) {
+      channelUsed[i] = true;
+      found = i;
+    }
+  }
+  if (!primask) __enable_irq();
+  if (found == -1) return -1;
+
+  // Edge select only applies to sync/resync paths
+  EVSYS->Channel[found].CHANNEL.reg = EVSYS_CHANNEL_EVGEN(generatorID)
+    | EVSYS_CHANNEL_PATH(path)
+    | (path == EVENT_PATH_ASYNC ? EVSYS_CHANNEL_EDGSEL_NO_EVT_OUTPUT 
+                                : EVSYS_CHANNEL_EDGSEL_RISING_EDGE);
+
+  if (!addUser(found, userID)) {
+    disconnect(found);
+    return -1;
+  }
+  return found;
+}
+
+// Fans one channel out to another user (e.g. a second DMA stage or a peripheral start input)
+bool System_::EVNTUtil::addUser(int16_t eventChannel, uint8_t userID) {
+  if (!isConnected(eventChannel) || userID >= EVNT_USER_COUNT) return false;
+  EVSYS->USER[userID].reg = EVSYS_USER_CHANNEL(eventChannel + 1); // 0 -> no channel
+  return true;
+}
+
+bool System_::EVNTUtil::removeUser(uint8_t userID) {
+  if (userID >= EVNT_USER_COUNT) return false;
+  EVSYS->USER[userID].reg = 0;
+  return true;
+}
+
+// Detaches every user of the channel & frees it
+bool System_::EVNTUtil::disconnect(int16_t eventChannel) {
+  if (!isConnected(eventChannel)) return false;
+
+  for (int16_t i = 0; i < EVNT_USER_COUNT; i++) {
+    if (EVSYS->USER[i].bit.CHANNEL == eventChannel + 1) {
+      EVSYS->USER[i].reg = 0;
+    }
+  }
+  EVSYS->Channel[eventChannel].CHANNEL.reg = 0;
+  channelUsed[eventChannel] = false;
+  return true;
+}
+
+bool System_::EVNTUtil::isConnected(int16_t eventChannel) {
+  return (eventChannel >= 0 && eventChannel < EVNT_CHANNEL_COUNT && channelUsed[eventChannel]);
+}
+
+// Source block complete -> action on target, so a multi stage move runs w/o an ISR between
+// stages. Source must be channel 0 - 3 & target 0 - 7 (see DMAChannelRequest event flags).
+// Note -> target keeps its trigger action, e.g. ACTION_TRANSFER_BLOCK moves one block per event
+int16_t System_::EVNTUtil::linkChannels(TransferChannel &source, TransferChannel &target, 
+  DMA_EVENT_ACTION action) {
+  if (source.channelIndex >= DMA_EVENT_OUTPUT_CHANNELS 
+  || target.channelIndex >= DMA_EVENT_INPUT_CHANNELS
+  || action == EVENT_ACTION_NONE) {
+    return -1;
+  }
+  int16_t eventChannel = connect(EVNT_DMAC_GENERATOR + source.channelIndex,
+    EVNT_DMAC_USER + target.channelIndex, EVENT_PATH_ASYNC);
+  if (eventChannel == -1) return -1;
+
+  target.settings.setEventInput(action);
+  source.settings.setEventOutput(EVENT_OUTPUT_BLOCK);
+  return eventChannel;
+}
+
+// Source block complete -> peripheral event input (e.g. EVSYS_ID_USER_ADC0_START)
+// Note -> peripheral must have its event input enabled (EVCTRL) by its own module
+int16_t System_::EVNTUtil::linkChannel(TransferChannel &source, uint8_t userID) {
+  if (source.channelIndex >= DMA_EVENT_OUTPUT_CHANNELS) return -1;
+
+  int16_t eventChannel = connect(EVNT_DMAC_GENERATOR + source.channelIndex, userID, 
+    EVENT_PATH_ASYNC);
+  if (eventChannel == -1) return -1;
+
+  source.settings.setEventOutput(EVENT_OUTPUT_BLOCK);
+  return eventChannel;
+}
+
+// Inputs of linked DMA channels are left as they are (freeChannel resets them)
+bool System_::EVNTUtil::unlinkChannel(TransferChannel &source, int16_t eventChannel) {
+  if (!disconnect(eventChannel)) return false;
+  source.settings.setEventOutput(EVENT_OUTPUT_NONE);
+  return true;
+}
+
+void System_::EVNTUtil::init() {
+  if (begun) return;
+  MCLK->APBBMASK.reg |= MCLK_APBBMASK_EVSYS;
+  EVSYS->CTRLA.bit.SWRST = 1;
+  while(EVSYS->CTRLA.bit.SWRST);
+  memset(channelUsed, 0, sizeof(channelUsed));
+  begun = true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> TIMER UTILITY (TIM)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns a stopped timer (-1 if none free) -> 16 bit, counts to CC0 & wraps (match frequency)
+int16_t System_::TIMUtil::allocTimer() {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  int16_t found = -1;
+  for (int16_t i = 0; i < TIM_TIMER_COUNT && found == -1; i++) {
+    if (!timerUsed[i]) {
+      timerUsed[i] = true;
+      found = i;
+    }
+  }
+  if (!primask) __enable_irq();
+  if (found == -1) return -1;
+
+  init(found);
+  return found;
+}
+
+void System_::TIMUtil::freeTimer(int16_t timer) {
+  if (!isAllocated(timer)) return;
+  stop(timer);
+  TIMER_REF[timer].tc->COUNT16.CTRLA.bit.SWRST = 1;
+  while(TIMER_REF[timer].tc->COUNT16.SYNCBUSY.bit.SWRST);
+  timerRate[timer] = 0;
+  timerUsed[timer] = false;
+}
+
+// Closest rate the counter can make (smallest prescaler that fits -> finest period step).
+// Returns the actual rate, 0 if out of range. Note -> stops the timer while the period changes
+float System_::TIMUtil::setRate(int16_t timer, float hz) {
+  if (!isAllocated(timer) || hz <= 0) return 0;
+  Tc *tc = TIMER_REF[timer].tc;
+
+  for (int16_t i = 0; i < (int16_t)(sizeof(TIMER_PRESCALERS) / sizeof(TIMER_PRESCALERS[0])); i++) {
+    uint32_t period = (uint32_t)((float)TIM_CLOCK_HZ / (TIMER_PRESCALERS[i] * hz) + 0.5f);
+    if (period == 0) return 0;
+    if (period > TIM_MAX_PERIOD) continue;
+
+    bool running = isRunning(timer);
+    stop(timer);
+    tc->COUNT16.CTRLA.bit.PRESCALER = i;          // Enable protected
+    tc->COUNT16.CC[0].reg = (uint16_t)(period - 1);
+    while(tc->COUNT16.SYNCBUSY.bit.CC0);
+
+    timerRate[timer] = (float)TIM_CLOCK_HZ / ((float)TIMER_PRESCALERS[i] * period);
+    if (running) start(timer);
+    return timerRate[timer];
+  }
+  return 0;
+}
+
+float System_::TIMUtil::getRate(int16_t timer) {
+  return isAllocated(timer) ? timerRate[timer] : 0;
+}
+
+// Counter starts from 0 -> first overflow is one full period after this
+bool System_::TIMUtil::start(int16_t timer) {
+  if (!isAllocated(timer) || timerRate[timer] == 0) return false;
+  Tc *tc = TIMER_REF[timer].tc;
+  if (tc->COUNT16.CTRLA.bit.ENABLE) return true;
+
+  tc->COUNT16.COUNT.reg = 0;
+  while(tc->COUNT16.SYNCBUSY.bit.COUNT);
+  tc->COUNT16.CTRLA.bit.ENABLE = 1;
+  while(tc->COUNT16.SYNCBUSY.bit.ENABLE);
+  return true;
+}
+
+bool System_::TIMUtil::stop(int16_t timer) {
+  if (!isAllocated(timer)) return false;
+  Tc *tc = TIMER_REF[timer].tc;
+  tc->COUNT16.CTRLA.bit.ENABLE = 0;
+  while(tc->COUNT16.SYNCBUSY.bit.ENABLE);
+  return true;
+}
+
+bool System_::TIMUtil::isRunning(int16_t timer) {
+  return isAllocated(timer) && TIMER_REF[timer].tc->COUNT16.CTRLA.bit.ENABLE;
+}
+
+DMA_TRIGGER System_::TIMUtil::getTrigger(int16_t timer) {
+  return isAllocated(timer) ? TIMER_REF[timer].trigger : TRIGGER_SOFTWARE;
+}
+
+uint8_t System_::TIMUtil::getEventGenerator(int16_t timer) {
+  return isAllocated(timer) ? TIMER_REF[timer].eventGenerator : 0;
+}
+
+bool System_::TIMUtil::isAllocated(int16_t timer) {
+  return (timer >= 0 && timer < TIM_TIMER_COUNT && timerUsed[timer]);
+}
+
+void System_::TIMUtil::init(int16_t timer) {
+  switch (timer) {
+    case 0: MCLK->APBAMASK.reg |= MCLK_APBAMASK_TC0; break;
+    case 1: MCLK->APBAMASK.reg |= MCLK_APBAMASK_TC1; break;
+    case 2: MCLK->APBBMASK.reg |= MCLK_APBBMASK_TC2; break;
+    case 3: MCLK->APBBMASK.reg |= MCLK_APBBMASK_TC3; break;
+  }
+  GCLK->PCHCTRL[TIMER_REF[timer].clockID].reg = TIM_GCLK_GENERATOR | GCLK_PCHCTRL_CHEN;
+  while(!(GCLK->PCHCTRL[TIMER_REF[timer].clockID].reg & GCLK_PCHCTRL_CHEN));
+
+  Tc *tc = TIMER_REF[timer].tc;
+  tc->COUNT16.CTRLA.bit.SWRST = 1;
+  while(tc->COUNT16.SYNCBUSY.bit.SWRST);
+
+  // Overflow @ CC0 -> DMA request (OVF) & event output
+  tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16;
+  tc->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+  tc->COUNT16.EVCTRL.reg = TC_EVCTRL_OVFEO;
+  timerRate[timer] = 0;
+}
@@ -0,0 +1,23 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> BENCH (NATIVE ENV ONLY)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Shared by the bench files, main() & the helpers live in DMABench.cpp
+
+#pragma once
+#include <Arduino.h>
+#include <stdio.h>
+
+uint64_t hostNanos();
+
+// Counts a failure & prints what failed -> main() exits non zero if any
+void check(bool passed, const char *what);
+
+void fillPattern(uint8_t *data, uint32_t length, uint8_t seed);
+
+//// Bench sections (one per file) ////
+void benchCOM();
+
+void benchFrame();
+
+void benchRing();
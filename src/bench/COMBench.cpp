@@ -0,0 +1,384 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> COM BENCH (NATIVE ENV ONLY)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Runs the COM send queue against the bulk IN endpoint model (lib/SAMD51Sim/SimUSB.h). The glue
+// below does what COM_::enqueue(), armNext() & COMHandler() do around the queue, the model is
+// what the host sees -> packets, short packets & where its transfers end. The receive ring is
+// run on its own (no OUT endpoint in the model).
+
+#include <Arduino.h>
+#include <COMQueue.h>
+#include <FRAME.h>
+#include "Bench.h"
+
+#define BENCH_COM_BUFFER_BYTES 4096
+#define BENCH_COM_STREAM_SENDS 200
+#define BENCH_COM_MAX_TRANSFERS 64
+#define BENCH_COM_POLL_LIMIT 100000
+#define BENCH_FRAME_COUNT 24
+#define BENCH_FRAME_BLOCK 1024         // Pipe sized payload (packet multiple)
+#define BENCH_FRAME_SMALL 120          // Stats sized payload (3 records)
+#define BENCH_RX_PACKETS 2000
+
+static COMSendQueue queue;
+static bool autoZLP = COM_DEFAULT_AUTO_ZLP;
+
+static __attribute__((__aligned__(4))) uint8_t comData[4][BENCH_COM_BUFFER_BYTES];
+static uint8_t received[BENCH_COM_BUFFER_BYTES * 8];
+static uint32_t receivedBytes = 0;
+static uint32_t transferLengths[BENCH_COM_MAX_TRANSFERS];
+static uint32_t transferCount = 0;
+
+static void *releaseOrder[COM_SEND_QUEUE_LENGTH];
+static uint32_t releaseCount = 0;
+
+//// Driver side (as COM_) ////
+static void armNext() {
+  COMSendSpan span;
+  if (!queue.next(span)) return;
+  bool zlp = autoZLP && span.endTransfer && (span.numBytes % COM_PACKET_SIZE == 0);
+  simUSBArmIn((uint32_t)(uintptr_t)span.address, span.numBytes, zlp);
+}
+
+static void benchUSBHandler() {
+  simUSBClearTRCPT1();
+  queue.complete();
+  armNext();
+
+  COMSendEntry done;
+  while (queue.release(done)) {
+    if (done.releaseCB != nullptr) done.releaseCB(done.source);
+  }
+}
+
+static bool enqueue(void *source, uint16_t numBytes, COMSendCallback releaseCallback,
+  bool endTransfer) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  bool queued = queue.push({ source, numBytes, releaseCallback, endTransfer });
+  if (queued && !queue.isArmed()) armNext();
+  if (!primask) __enable_irq();
+  return queued;
+}
+
+// Stands in for COM.cpp's -> FrameEncoder sends through the same queue & endpoint model
+bool COMEnqueue(const COMSendEntry *entries, int16_t count) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (queue.space() < count) {
+    if (!primask) __enable_irq();
+    return false;
+  }
+  for (int16_t i = 0; i < count; i++) queue.push(entries[i]);
+  if (!queue.isArmed()) armNext();
+  if (!primask) __enable_irq();
+  return true;
+}
+
+static void abortSend() {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  simUSBDisarmIn();
+  queue.abort();
+  COMSendEntry entry;
+  while (queue.release(entry)) {
+    if (entry.releaseCB != nullptr) entry.releaseCB(entry.source);
+  }
+  if (!primask) __enable_irq();
+}
+
+//// Host side ////
+static void recordTransfer(const uint8_t *data, uint32_t length) {
+  if (transferCount < BENCH_COM_MAX_TRANSFERS) transferLengths[transferCount] = length;
+  transferCount++;
+  uint32_t count = MIN(length, sizeof(received) - receivedBytes);
+  memcpy(received + receivedBytes, data, count);
+  receivedBytes += count;
+}
+
+static void recordRelease(void *source) {
+  if (releaseCount < COM_SEND_QUEUE_LENGTH) releaseOrder[releaseCount] = source;
+  releaseCount++;
+}
+
+static bool drain() {
+  for (uint32_t i = 0; i < BENCH_COM_POLL_LIMIT && queue.busy(); i++) {
+    simUSBHostPoll(1);
+  }
+  return !queue.busy();
+}
+
+static void resetBench() {
+  queue.reset();
+  simUSBReset();
+  simUSBSetTransferCallback(recordTransfer);
+  USB_SetHandler(benchUSBHandler);
+  receivedBytes = 0;
+  transferCount = 0;
+  releaseCount = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> SEND QUEUE
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// One entry per transfer -> ZLP after full last packets, release in queue order
+static void benchCOMTransfers() {
+  printf("COM send queue (endpoint model)\n");
+  resetBench();
+  for (int16_t i = 0; i < 3; i++) fillPattern(comData[i], BENCH_COM_BUFFER_BYTES, 11 * i);
+
+  const uint16_t lengths[3] = { 1024, 100, 128 };
+  for (int16_t i = 0; i < 3; i++) {
+    check(enqueue(comData[i], lengths[i], recordRelease, true), "enqueue");
+  }
+  check(drain(), "queue drained");
+
+  SimUSBStats stats;
+  simUSBGetStats(stats);
+  check(transferCount == 3 && transferLengths[0] == 1024 && transferLengths[1] == 100
+    && transferLengths[2] == 128, "one host transfer per ending entry");
+  check(stats.zlps == 2, "ZLP after full last packets only");
+  check(memcmp(received, comData[0], 1024) == 0 && memcmp(received + 1024, comData[1], 100) == 0
+    && memcmp(received + 1124, comData[2], 128) == 0, "host got the data in order");
+  check(releaseCount == 3 && releaseOrder[0] == comData[0] && releaseOrder[1] == comData[1]
+    && releaseOrder[2] == comData[2], "released in queue order");
+
+  // Entries w/o endTransfer run on into the next one -> one transfer
+  resetBench();
+  enqueue(comData[0], 256, nullptr, false);
+  enqueue(comData[1], 256, nullptr, false);
+  enqueue(comData[2], 64, nullptr, true);
+  check(drain(), "queue drained");
+  simUSBGetStats(stats);
+  check(transferCount == 1 && transferLengths[0] == 576 && stats.zlps == 1,
+    "entries joined into one transfer");
+}
+
+// Queue full -> enqueue fails instead of blocking, abort gives every buffer back
+static void benchCOMBackpressure() {
+  resetBench();
+  int16_t accepted = 0;
+  while (enqueue(comData[0], 512, recordRelease, true) && accepted < COM_SEND_QUEUE_LENGTH) {
+    accepted++;
+  }
+  check(accepted == COM_SEND_QUEUE_LENGTH - 1 && queue.space() == 0, "backpressure when full");
+  check(drain() && releaseCount == (uint32_t)accepted && queue.count() == 0, "all released");
+
+  resetBench();
+  for (int16_t i = 0; i < 3; i++) enqueue(comData[i], 1024, recordRelease, true);
+  simUSBHostPoll(2);
+  abortSend();
+  check(releaseCount == 3 && !queue.busy() && !simUSBGetInBank().BK1RDY, "abort releases all");
+}
+
+// Owner re-queues each buffer from its release callback -> endpoint never idles
+static int16_t streamSends = 0;
+
+static void streamRelease(void *source) {
+  if (++streamSends <= BENCH_COM_STREAM_SENDS - 2) {
+    enqueue(source, BENCH_COM_BUFFER_BYTES, streamRelease, true);
+  }
+}
+
+static void benchCOMStream() {
+  resetBench();
+  streamSends = 0;
+  uint64_t start = simCycles();
+  enqueue(comData[0], BENCH_COM_BUFFER_BYTES, streamRelease, true);
+  enqueue(comData[1], BENCH_COM_BUFFER_BYTES, streamRelease, true);
+  check(drain(), "stream drained");
+  uint64_t cycles = simCycles() - start;
+
+  SimUSBStats stats;
+  simUSBGetStats(stats);
+  double kbps = (double)stats.bytes / 1024.0 / ((double)cycles / F_CPU);
+  printf("  %d x %d bytes -> %lu packets, %lu transfers, %lu naks, %.0f KB/s (FS bulk max %.0f)\n",
+    BENCH_COM_STREAM_SENDS, BENCH_COM_BUFFER_BYTES, (unsigned long)stats.packets,
+    (unsigned long)stats.transfers, (unsigned long)stats.naks, kbps,
+    (double)SIM_USB_PACKET_SIZE * F_CPU / SIM_USB_PACKET_CYCLES / 1024.0);
+  check(stats.bytes == (uint64_t)BENCH_COM_STREAM_SENDS * BENCH_COM_BUFFER_BYTES,
+    "every stream buffer sent");
+  check(stats.naks == 0, "no gaps between buffers");
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> FRAMES OVER THE ENDPOINT
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Header, payload & trailer are 3 entries -> host must still see one transfer per frame w only
+// its last packet short, else every frame costs it 3 transfers
+static FrameEncoder benchFramer(1);
+static uint8_t decodeBuffer[BENCH_COM_BUFFER_BYTES];
+
+static void benchCOMFrames() {
+  printf("frames over the endpoint\n");
+  resetBench();
+  FrameDecoder decoder(decodeBuffer, sizeof(decodeBuffer));
+  fillPattern(comData[0], BENCH_COM_BUFFER_BYTES, 5);
+  fillPattern(comData[1], BENCH_COM_BUFFER_BYTES, 9);
+
+  int16_t framesSent = 0;
+  uint32_t payloadBytes = 0;
+  for (int16_t i = 0; i < BENCH_FRAME_COUNT; i++) {
+    bool small = (i % 3 == 2);
+    uint16_t length = small ? BENCH_FRAME_SMALL : BENCH_FRAME_BLOCK;
+    // Refused sends count as dropped frames (sequence gap) -> wait for room like a pipe would
+    while (queue.space() < FRAME_SEND_ENTRIES) simUSBHostPoll(1);
+    check(benchFramer.send(comData[small], length), "frame queued");
+    framesSent++;
+    payloadBytes += length;
+  }
+  check(drain(), "frames drained");
+
+  SimUSBStats stats;
+  simUSBGetStats(stats);
+  printf("  %d frames -> %lu packets, %lu short, %lu transfers\n", framesSent,
+    (unsigned long)stats.packets, (unsigned long)stats.shortPackets,
+    (unsigned long)stats.transfers);
+  check(stats.transfers == (uint32_t)framesSent, "one host transfer per frame");
+  check(stats.shortPackets == (uint32_t)framesSent, "only the last packet of a frame is short");
+  check(stats.bytes == payloadBytes + (uint32_t)framesSent * FRAME_OVERHEAD, "no bytes lost");
+
+  // Host side -> decode what came in
+  uint32_t offset = 0;
+  int16_t valid = 0;
+  while (offset < receivedBytes) {
+    offset += decoder.push(received + offset, receivedBytes - offset);
+    while (decoder.available()) {
+      const FrameHeader *header = decoder.getHeader();
+      bool small = (header->payloadLength == BENCH_FRAME_SMALL);
+      if (decoder.getPayloadValid()
+      && memcmp(decoder.getPayload(), comData[small], header->payloadLength) == 0) {
+        valid++;
+      }
+      decoder.next();
+    }
+  }
+  check(valid == framesSent && decoder.sequenceGaps() == 0, "host decoded every frame");
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> RECEIVE RING
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// OUT bank glue as COM_::commitRX() & armRX() do it -> the model has no OUT endpoint, so the
+// "host" writes each packet straight into the slot the bank is armed on
+static COMReceiveRing rxRing;
+static uint8_t *rxBank = nullptr;       // nullptr -> ring full, bank stalled (host gets NAK)
+
+static void armRX() { rxBank = rxRing.armSlot(); }
+
+static bool hostWrite(uint16_t length, uint8_t seed) {
+  if (rxBank == nullptr) return false;
+  fillPattern(rxBank, length, seed);
+  rxRing.commit(length);
+  armRX();
+  return true;
+}
+
+static bool packetMatches(const uint8_t *packet, uint16_t length, uint8_t seed) {
+  static uint8_t expected[COM_PACKET_SIZE];
+  fillPattern(expected, length, seed);
+  return packet != nullptr && memcmp(packet, expected, length) == 0;
+}
+
+// Reader side as COM_::releasePacket() -> stalled bank re-armed on the slot just freed
+static void releaseRX() {
+  rxRing.release();
+  if (rxBank == nullptr) armRX();
+}
+
+// As COM_::flush() -> newest dropped or bank stalled -> (re-)armed on the head slot
+static int16_t flushRX(int16_t numPackets) {
+  int16_t dropped = rxRing.flush(numPackets);
+  if (dropped < 0 || rxBank == nullptr) armRX();
+  return dropped;
+}
+
+// Odd sized packets, reader takes a few at a time -> order & lengths survive the uint8 wrap
+static void benchRXOrder() {
+  printf("COM receive ring\n");
+  rxRing.reset();
+  armRX();
+  uint32_t written = 0;
+  uint32_t read = 0;
+  uint32_t bad = 0;
+  uint32_t seed = 17;
+  while (read < BENCH_RX_PACKETS) {
+    seed = seed * 1103515245u + 12345u;
+    int16_t burst = (seed >> 16) % (COM_RX_PACKETS + 3);
+    for (int16_t i = 0; i < burst && written < BENCH_RX_PACKETS; i++) {
+      if (!hostWrite(1 + written % COM_PACKET_SIZE, (uint8_t)written)) break;
+      written++;
+    }
+    int16_t take = (seed >> 20) % 4 + 1;
+    uint8_t *packet;
+    int16_t length;
+    while (take-- > 0 && (length = rxRing.read(packet)) > 0) {
+      if (length != 1 + read % COM_PACKET_SIZE || !packetMatches(packet, length, (uint8_t)read)) {
+        bad++;
+      }
+      read++;
+      releaseRX();
+    }
+  }
+  check(bad == 0 && rxRing.available(true) == 0, "every packet once, in order (wraps)");
+}
+
+// Full ring -> bank not armed until a release, byte count covers every held packet
+static void benchRXFull() {
+  rxRing.reset();
+  armRX();
+  int16_t accepted = 0;
+  while (hostWrite(COM_PACKET_SIZE - accepted, accepted) && accepted <= COM_RX_PACKETS) accepted++;
+  check(accepted == COM_RX_PACKETS && rxBank == nullptr, "full ring stalls the bank");
+  check(rxRing.available(true) == COM_RX_PACKETS && rxRing.available(false)
+    == COM_RX_PACKETS * COM_PACKET_SIZE - COM_RX_PACKETS * (COM_RX_PACKETS - 1) / 2,
+    "full ring counts");
+  check(rxRing.inspect(COM_RX_PACKETS + 5) == rxRing.inspect(COM_RX_PACKETS - 1)
+    && packetMatches(rxRing.inspect(200), 1 + COM_PACKET_SIZE - COM_RX_PACKETS,
+    COM_RX_PACKETS - 1), "inspect past the newest gives the newest");
+
+  releaseRX();
+  check(rxBank != nullptr && hostWrite(10, 99), "release re-arms the bank");
+}
+
+// As COM_::flush() -> clamped to what is held, newest dropped -> bank re-armed on the new head
+static void benchRXFlush() {
+  rxRing.reset();
+  armRX();
+  uint8_t *firstSlot = rxBank;
+  check(flushRX(-1) == 0 && flushRX(5) == 0 && rxRing.available(true) == 0
+    && rxRing.armSlot() == firstSlot, "flush on an empty ring drops nothing");
+  check(rxRing.inspect(0) == nullptr, "nothing to inspect");
+
+  for (int16_t i = 0; i < COM_RX_PACKETS; i++) hostWrite(32, i);
+  check(flushRX(-1) == -1 && rxRing.available(true) == COM_RX_PACKETS - 1,
+    "flush drops the last received packet");
+  check(hostWrite(16, 77) && packetMatches(rxRing.inspect(COM_RX_PACKETS - 1), 16, 77),
+    "bank re-armed on the dropped slot");
+  uint8_t *packet;
+  check(flushRX(2) == 2 && rxRing.read(packet) == 32 && packetMatches(packet, 32, 2),
+    "flush drops the oldest");
+  int16_t held = rxRing.available(true);
+  check(flushRX(100) == held && rxRing.available(true) == 0 && rxRing.read(packet) == 0,
+    "flush past the count empties the ring");
+
+  for (int16_t i = 0; i < COM_RX_PACKETS; i++) hostWrite(8, i);
+  check(flushRX(-100) == -COM_RX_PACKETS && rxRing.available(true) == 0, 
+    "flush of a full ring from the newest end");
+  check(hostWrite(8, 5) && rxRing.read(packet) == 8 && packetMatches(packet, 8, 5),
+    "ring usable after flush");
+}
+
+void benchCOM() {
+  benchCOMTransfers();
+  benchCOMBackpressure();
+  benchCOMStream();
+  benchCOMFrames();
+  benchRXOrder();
+  benchRXFull();
+  benchRXFlush();
+}
@@ -0,0 +1,860 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> DMA BENCH (NATIVE ENV ONLY)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Runs the DMA module against the DMAC model (lib/SAMD51Sim). Host time is real time spent in
+// driver code, sim cycles are what the DMAC would take @ F_CPU. Exits non zero if a transfer
+// moved the wrong data, so CI can run it as is. main() also runs the other bench files (Bench.h).
+
+#include <Arduino.h>
+#include <DMA.h>
+#include <ADCRing.h>
+#include <stdio.h>
+#include <chrono>
+#include "Bench.h"
+
+#define BENCH_BLOCK_BYTES 256
+#define BENCH_CHAIN_LENGTH 4
+#define BENCH_SETUP_ROUNDS 20000
+#define BENCH_ISR_BLOCKS 5000
+#define BENCH_ASYNC_BYTES 65536
+#define BENCH_TUNING_BYTES 4096
+#define BENCH_TUNING_RESULTS 8
+#define BENCH_CAPTURE_LENGTH 256       // Samples
+#define BENCH_CAPTURE_PRE 64
+#define BENCH_CAPTURE_POST 100
+#define BENCH_CAPTURE_TRIGGER 700      // Sample # the "window" fires on
+#define BENCH_STREAM_BLOCKS 4
+#define BENCH_STREAM_BLOCK_LENGTH 32   // Samples
+#define BENCH_STREAM_WRAPS 4000
+#define BENCH_STREAM_MAX_MASK 56       // Samples w interrupts masked (< 2 blocks)
+#define BENCH_STREAM_READ_LAG 48       // Reader lets up to this many pile up (+ mask < 3 blocks)
+#define BENCH_SWAP_LENGTH 48           // Samples
+#define BENCH_TIMEOUT_CYCLES 50000000ul
+#define BENCH_TRIGGER TRIGGER_TC0_OOB
+
+static uint32_t failures = 0;
+static volatile uint32_t callbackCount = 0;
+static volatile DMA_CALLBACK_REASON lastReason = REASON_UNKNOWN;
+
+static __attribute__((__aligned__(4))) uint8_t source[BENCH_ASYNC_BYTES + 8];
+static __attribute__((__aligned__(4))) uint8_t destination[BENCH_ASYNC_BYTES + 8];
+
+//// Helpers ////
+uint64_t hostNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void check(bool passed, const char *what) {
+  if (!passed) {
+    failures++;
+    printf("  FAIL -> %s\n", what);
+  }
+}
+
+void fillPattern(uint8_t *data, uint32_t length, uint8_t seed) {
+  for (uint32_t i = 0; i < length; i++) data[i] = (uint8_t)(i * 31 + seed);
+}
+
+static void countCallback(DMA_CALLBACK_REASON reason, TransferChannel &source,
+  int16_t descriptorIndex) {
+  (void)source;
+  (void)descriptorIndex;
+  lastReason = reason;
+  callbackCount++;
+}
+
+static void printStats(TransferChannel &channel) {
+  DMAChannelStats stats;
+  SimDMACStats sim;
+  if (!channel.getStats(stats) || !simDMACGetStats(channel.channelIndex, sim)) return;
+  printf("  channel %d -> %lu blocks, %lu bytes, %lu irqs, %lu callbacks, %lu errors\n",
+    channel.channelIndex, (unsigned long)stats.blocksCompleted, (unsigned long)stats.bytesMoved,
+    (unsigned long)stats.interrupts, (unsigned long)stats.callbacks, (unsigned long)stats.errors);
+  printf("  dmac -> %lu fetches, %lu beats, %llu busy cycles\n", (unsigned long)sim.fetches,
+    (unsigned long)sim.beats, (unsigned long long)sim.busyCycles);
+}
+
+static void printIRQ(IRQn_Type irq) {
+  SimIRQStats stats;
+  if (!simGetIRQStats(irq, stats) || stats.calls == 0) return;
+  printf("  DMAC_%d_Handler -> %lu calls, %.0f ns avg, %llu ns max (host)\n", irq - DMAC_0_IRQn,
+    (unsigned long)stats.calls, (double)stats.hostNanos / stats.calls,
+    (unsigned long long)stats.hostNanosMax);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> DESCRIPTOR SETUP
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static TransferDescriptor chain[BENCH_CHAIN_LENGTH];
+static TransferDescriptor *chainPtrs[BENCH_CHAIN_LENGTH];
+
+static void buildChain(DMA_TRANSFER_ACTION lastAction) {
+  for (int16_t i = 0; i < BENCH_CHAIN_LENGTH; i++) {
+    chain[i].setDataSize(4)
+      .setIncrementConfig(true, true)
+      .setTransferAmount(BENCH_BLOCK_BYTES / 4)
+      .setAction(i == BENCH_CHAIN_LENGTH - 1 ? lastAction : ACTION_NONE)
+      .setSource(source + i * BENCH_BLOCK_BYTES, true)
+      .setDestination(destination + i * BENCH_BLOCK_BYTES, true);
+    chainPtrs[i] = &chain[i];
+  }
+}
+
+static void benchSetup(TransferChannel &channel) {
+  printf("descriptor setup\n");
+  buildChain(ACTION_BLOCK_INTERRUPT);
+
+  uint64_t start = hostNanos();
+  for (int32_t i = 0; i < BENCH_SETUP_ROUNDS; i++) {
+    channel.setDescriptors(chainPtrs, BENCH_CHAIN_LENGTH, false, false);
+  }
+  uint64_t setNanos = hostNanos() - start;
+
+  start = hostNanos();
+  for (int32_t i = 0; i < BENCH_SETUP_ROUNDS; i++) {
+    channel.replaceDescriptor(&chain[i % BENCH_CHAIN_LENGTH], i % BENCH_CHAIN_LENGTH, false);
+  }
+  uint64_t replaceNanos = hostNanos() - start;
+
+  start = hostNanos();
+  volatile uint32_t sink = 0;
+  for (int32_t i = 0; i < BENCH_SETUP_ROUNDS; i++) {
+    const DmacDescriptor *desc = channel.descriptor(i % BENCH_CHAIN_LENGTH);
+    if (desc != nullptr) sink = sink + desc->BTCNT.reg;
+  }
+  uint64_t lookupNanos = hostNanos() - start;
+
+  printf("  setDescriptors(%d) -> %.0f ns\n", BENCH_CHAIN_LENGTH,
+    (double)setNanos / BENCH_SETUP_ROUNDS);
+  printf("  replaceDescriptor -> %.0f ns\n", (double)replaceNanos / BENCH_SETUP_ROUNDS);
+  printf("  descriptor(i) -> %.1f ns\n", (double)lookupNanos / BENCH_SETUP_ROUNDS);
+  check(channel.getDescriptorCount() == BENCH_CHAIN_LENGTH, "descriptor count after setup");
+  check(DMA.descriptorsUsed(channel.channelIndex) == BENCH_CHAIN_LENGTH - 1
+    && DMA.descriptorsUsed(-1) == 0 && DMA.descriptorsUsed(DMA_MAX_CHANNELS) == 0,
+    "pool usage per channel");
+}
+
+// Same chain as buildChain(), formed at compile time -> attach() is just the links
+typedef StaticDescriptor<4, BENCH_BLOCK_BYTES / 4> BenchBlock;
+typedef StaticDescriptor<4, BENCH_BLOCK_BYTES / 4, true, true, ACTION_BLOCK_INTERRUPT> BenchLastBlock;
+static StaticChain<BenchBlock, BenchBlock, BenchBlock, BenchLastBlock> staticChain;
+
+static void benchStaticChain(TransferChannel &channel) {
+  printf("static descriptor chain\n");
+  uint32_t *src = (uint32_t*)source;
+  uint32_t *dst = (uint32_t*)destination;
+  const int16_t words = BENCH_BLOCK_BYTES / 4;
+  staticChain
+    .setAddresses<0>(src, dst)
+    .setAddresses<1>(src + words, dst + words)
+    .setAddresses<2>(src + 2 * words, dst + 2 * words)
+    .setAddresses<3>(src + 3 * words, dst + 3 * words);
+
+  uint64_t start = hostNanos();
+  for (int32_t i = 0; i < BENCH_SETUP_ROUNDS; i++) {
+    staticChain.attach(channel);
+  }
+  uint64_t attachNanos = hostNanos() - start;
+  printf("  attach(%d) -> %.0f ns\n", staticChain.length(), 
+    (double)attachNanos / BENCH_SETUP_ROUNDS);
+  check(channel.getDescriptorCount() == staticChain.length(), "static chain count");
+
+  fillPattern(source, BENCH_BLOCK_BYTES * BENCH_CHAIN_LENGTH, 17);
+  memset(destination, 0, sizeof(destination));
+  channel.settings.setTriggerAction(ACTION_TRANSFER_ALL);
+  channel.enable();
+  channel.trigger();
+  simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  check(memcmp(destination, source, BENCH_BLOCK_BYTES * BENCH_CHAIN_LENGTH) == 0,
+    "static chain data");
+  channel.disable(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> TRANSFERS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Whole chain on one software trigger -> checks end address math & linking
+static void benchTransaction(TransferChannel &channel) {
+  printf("linked transaction (%d x %d bytes)\n", BENCH_CHAIN_LENGTH, BENCH_BLOCK_BYTES);
+  fillPattern(source, BENCH_CHAIN_LENGTH * BENCH_BLOCK_BYTES, 7);
+  memset(destination, 0, BENCH_CHAIN_LENGTH * BENCH_BLOCK_BYTES);
+  buildChain(ACTION_BLOCK_INTERRUPT);
+  channel.settings.setTriggerAction(ACTION_TRANSFER_ALL)
+    .setCallbackFunction(countCallback)
+    .setCallbackConfig(true, true, false);
+  channel.setDescriptors(chainPtrs, BENCH_CHAIN_LENGTH, false, false);
+  channel.clearStats();
+  simDMACClearStats();
+  callbackCount = 0;
+
+  uint64_t startCycles = simCycles();
+  check(channel.enable() && channel.trigger(), "enable & trigger");
+  check(simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES), "transaction finished");
+  uint64_t cycles = simCycles() - startCycles;
+
+  check(memcmp(source, destination, BENCH_CHAIN_LENGTH * BENCH_BLOCK_BYTES) == 0,
+    "transaction data");
+  check(callbackCount == 1, "one callback for the transaction");
+  printf("  %llu sim cycles (%.2f bytes/cycle)\n", (unsigned long long)cycles,
+    (double)(BENCH_CHAIN_LENGTH * BENCH_BLOCK_BYTES) / cycles);
+  printStats(channel);
+}
+
+// Looped chain, interrupt on every block, one peripheral trigger per block -> ISR path cost
+static void benchISR(TransferChannel &channel) {
+  printf("isr path (%d blocks, looped, external trigger)\n", BENCH_ISR_BLOCKS);
+  for (int16_t i = 0; i < BENCH_CHAIN_LENGTH; i++) {
+    chain[i].setAction(ACTION_BLOCK_INTERRUPT);
+  }
+  channel.settings.setTriggerAction(ACTION_TRANSFER_BLOCK)
+    .setExternalTrigger(BENCH_TRIGGER)
+    .setCallbackFunction(countCallback)
+    .setCallbackConfig(true, true, false)
+    .setDescriptorsLooped(true, false);
+  channel.setDescriptors(chainPtrs, BENCH_CHAIN_LENGTH, false, false);
+  channel.enableExternalTrigger();
+  channel.clearStats();
+  simDMACClearStats();
+  simClearIRQStats();
+  callbackCount = 0;
+
+  check(channel.enable(), "enable");
+  uint64_t startCycles = simCycles();
+  for (int32_t i = 0; i < BENCH_ISR_BLOCKS; i++) {
+    simDMACTrigger(BENCH_TRIGGER);
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  }
+  uint64_t cycles = simCycles() - startCycles;
+  check(callbackCount == BENCH_ISR_BLOCKS, "callback per block");
+  check(channel.getEnabled(), "looped chain still running");
+
+  printf("  %.1f sim cycles per block\n", (double)cycles / BENCH_ISR_BLOCKS);
+  printStats(channel);
+  printIRQ((IRQn_Type)(DMAC_0_IRQn + MIN(channel.channelIndex, 4)));
+
+  channel.disable(true);
+  channel.disableExternalTrigger();
+  channel.settings.setDescriptorsLooped(false, false);
+}
+
+// Re-point a descriptor of a running looped chain -> next pass must use the new source
+static void benchLiveUpdate(TransferChannel &channel) {
+  printf("live descriptor update\n");
+  static __attribute__((__aligned__(4))) uint8_t altSource[BENCH_BLOCK_BYTES];
+  fillPattern(altSource, BENCH_BLOCK_BYTES, 99);
+
+  channel.settings.setTriggerAction(ACTION_TRANSFER_BLOCK)
+    .setExternalTrigger(BENCH_TRIGGER)
+    .setDescriptorsLooped(true, false);
+  channel.setDescriptors(chainPtrs, BENCH_CHAIN_LENGTH, false, false);
+  channel.enableExternalTrigger();
+  channel.enable();
+  simDMACTrigger(BENCH_TRIGGER);
+  simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+
+  TransferDescriptor updated(chain[1]);
+  updated.setSource(altSource, true);
+  uint64_t start = hostNanos();
+  check(channel.updateDescriptor(&updated, 1), "updateDescriptor");
+  uint64_t nanos = hostNanos() - start;
+
+  for (int16_t i = 0; i < BENCH_CHAIN_LENGTH; i++) {
+    simDMACTrigger(BENCH_TRIGGER);
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  }
+  check(memcmp(destination + BENCH_BLOCK_BYTES, altSource, BENCH_BLOCK_BYTES) == 0,
+    "updated descriptor used on next pass");
+  printf("  updateDescriptor -> %llu ns (host)\n", (unsigned long long)nanos);
+
+  // Descriptor 0 lives in the primary slot -> its link must survive or the ring ends after it
+  static __attribute__((__aligned__(4))) uint8_t firstSource[BENCH_BLOCK_BYTES];
+  fillPattern(firstSource, BENCH_BLOCK_BYTES, 77);
+  TransferDescriptor updatedFirst(chain[0]);
+  updatedFirst.setSource(firstSource, true);
+  check(channel.updateDescriptor(&updatedFirst, 0), "updateDescriptor (primary)");
+
+  for (int16_t i = 0; i < 2 * BENCH_CHAIN_LENGTH; i++) {
+    if (i == BENCH_CHAIN_LENGTH) memset(destination, 0, BENCH_BLOCK_BYTES * BENCH_CHAIN_LENGTH);
+    simDMACTrigger(BENCH_TRIGGER);
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  }
+  check(memcmp(destination, firstSource, BENCH_BLOCK_BYTES) == 0
+    && memcmp(destination + BENCH_BLOCK_BYTES, altSource, BENCH_BLOCK_BYTES) == 0
+    && memcmp(destination + 2 * BENCH_BLOCK_BYTES, source + 2 * BENCH_BLOCK_BYTES,
+      2 * BENCH_BLOCK_BYTES) == 0, "primary updated, ring still looped");
+  check(channel.getEnabled(), "channel still running");
+
+  channel.disable(true);
+  channel.disableExternalTrigger();
+  channel.settings.setDescriptorsLooped(false, false);
+}
+
+// Bus error mid block -> error callback, channel disabled
+static void benchError(TransferChannel &channel) {
+  printf("transfer error path\n");
+  buildChain(ACTION_BLOCK_INTERRUPT);
+  channel.settings.setTriggerAction(ACTION_TRANSFER_ALL)
+    .setCallbackFunction(countCallback)
+    .setCallbackConfig(true, true, false);
+  channel.setDescriptors(chainPtrs, BENCH_CHAIN_LENGTH, false, false);
+  callbackCount = 0;
+  lastReason = REASON_UNKNOWN;
+
+  channel.enable();
+  simDMACInjectError(channel.channelIndex);
+  channel.trigger();
+  simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  check(lastReason == REASON_ERROR, "error callback");
+  check(!channel.getEnabled(), "channel disabled after error");
+}
+
+// Scope style capture the way the ADC runs it -> looped segments fed one beat per trigger, window
+// fires -> stop segment from the writeback (ADCFindCaptureStop) -> DMAC suspends itself after the
+// post samples. True if it did & the pre/post window around the trigger sample is intact.
+static uint16_t captureRing[BENCH_CAPTURE_LENGTH];
+
+static bool runCapture(TransferChannel &channel, uint32_t trigger, uint32_t post,
+  ADCCaptureStop &stop, uint32_t &fed, uint64_t &nanos) {
+  static volatile uint16_t result;  // Stands in for ADC RESULT
+  static TransferDescriptor segments[ADC_CAPTURE_DESC_COUNT];
+  TransferDescriptor *segmentPtrs[ADC_CAPTURE_DESC_COUNT];
+  const uint32_t segment = BENCH_CAPTURE_LENGTH / ADC_CAPTURE_DESC_COUNT;
+
+  memset(captureRing, 0, sizeof(captureRing));
+  for (int16_t i = 0; i < ADC_CAPTURE_DESC_COUNT; i++) {
+    segments[i].setAction(ACTION_NONE)
+      .setDataSize(2)
+      .setIncrementConfig(false, true)
+      .setTransferAmount(segment)
+      .setDestination(captureRing + i * segment, true)
+      .setSource((uint32_t)&result, false);
+    segmentPtrs[i] = &segments[i];
+  }
+  channel.settings.setTriggerAction(ACTION_TRANSFER_BURST)
+    .setBurstLength(1)
+    .setExternalTrigger(BENCH_TRIGGER)
+    .setCallbackFunction(countCallback)
+    .setCallbackConfig(true, true, false)
+    .setDescriptorsLooped(true, false);
+  channel.setDescriptors(segmentPtrs, ADC_CAPTURE_DESC_COUNT, false, false);
+  channel.enableExternalTrigger();
+  channel.enable();
+  lastReason = REASON_UNKNOWN;
+
+  stop = { 0, -1 };
+  bool armed = false;
+  for (fed = 0; lastReason != REASON_TRANSFER_COMPLETE_SUSPENDED 
+  && fed < trigger + BENCH_CAPTURE_LENGTH * 2; fed++) {
+    result = (uint16_t)fed;
+    simDMACTrigger(BENCH_TRIGGER);
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+
+    // Window ISR -> as ADCModule::triggerCapture
+    if (fed == trigger) {
+      uint64_t start = hostNanos();
+      armed = ADCFindCaptureStop(channel.getActiveIndex(), channel.remainingBytes() / 2,
+        BENCH_CAPTURE_LENGTH, post, stop)
+        && channel.setDescriptorAction(stop.stopSegment, ACTION_SUSPEND);
+      nanos = hostNanos() - start;
+    }
+  }
+  channel.disable(true);
+  channel.disableExternalTrigger();
+  channel.settings.setDescriptorsLooped(false, false);
+  if (!armed || lastReason != REASON_TRANSFER_COMPLETE_SUSPENDED 
+  || captureRing[stop.triggerIndex] != (uint16_t)trigger) {
+    return false;
+  }
+  for (uint32_t i = 0; i < BENCH_CAPTURE_PRE + post; i++) {
+    uint32_t index = (stop.triggerIndex + BENCH_CAPTURE_LENGTH - BENCH_CAPTURE_PRE + i) 
+      % BENCH_CAPTURE_LENGTH;
+    if (captureRing[index] != (uint16_t)(trigger - BENCH_CAPTURE_PRE + i)) return false;
+  }
+  return true;
+}
+
+static void benchTriggerCapture(TransferChannel &channel) {
+  printf("trigger capture\n");
+  ADCCaptureStop stop;
+  uint32_t fed = 0;
+  uint64_t nanos = 0;
+  check(runCapture(channel, BENCH_CAPTURE_TRIGGER, BENCH_CAPTURE_POST, stop, fed, nanos),
+    "suspended w the pre/post window intact");
+  printf("  trigger @ sample %d -> stop segment %d, %lu samples past it, %.0f ns to arm (host)\n",
+    BENCH_CAPTURE_TRIGGER, stop.stopSegment, (unsigned long)(fed - BENCH_CAPTURE_TRIGGER - 1),
+    (double)nanos);
+
+  // Window firing on every position of the ring, shortest & longest post -> covers the margin
+  // step (trigger near a segment end) & stop segments wrapping past the ring end
+  const uint32_t posts[2] = { 1, BENCH_CAPTURE_POST };
+  int16_t failed = 0;
+  for (uint32_t offset = 0; offset < BENCH_CAPTURE_LENGTH; offset++) {
+    for (int16_t i = 0; i < 2; i++) {
+      if (!runCapture(channel, BENCH_CAPTURE_TRIGGER + offset, posts[i], stop, fed, nanos)) {
+        failed++;
+      }
+    }
+  }
+  check(failed == 0, "every trigger position");
+
+  // Writeback cases the sweep cannot hit -> no active segment, next segment about to be fetched
+  check(!ADCFindCaptureStop(-1, 0, BENCH_CAPTURE_LENGTH, 1, stop), "no active segment");
+  check(ADCFindCaptureStop(2, ADC_CAPTURE_MARGIN - 1, BENCH_CAPTURE_LENGTH, 1, stop)
+    && stop.stopSegment == 4, "margin pushes the stop past the next segment");
+  check(ADCFindCaptureStop(ADC_CAPTURE_DESC_COUNT - 1, 32, BENCH_CAPTURE_LENGTH, 1, stop)
+    && stop.stopSegment == 0 && stop.triggerIndex == BENCH_CAPTURE_LENGTH - 33,
+    "stop wraps, trigger index is the last written sample");
+}
+
+// ADC stream -> looped blocks fed one beat per trigger while interrupts are masked for random
+// stretches, so TCMPLs arrive late & several blocks share one. The ISR & the reader are the
+// ADC's own (ADCBlockQueue), every sample must come out once, in order.
+static uint16_t streamBuffer[BENCH_STREAM_BLOCKS * BENCH_STREAM_BLOCK_LENGTH];
+static ADCBlockQueue streamQueue;
+static uint16_t streamExpected = 0;
+static uint32_t streamSamples = 0;
+static uint32_t streamMismatches = 0;
+static uint32_t streamCoalesced = 0;
+
+// Same as the stream branch of the ADC's dataDMACallback, minus split & user callback
+static void streamCallback(DMA_CALLBACK_REASON reason, TransferChannel &source,
+  int16_t descriptorIndex) {
+  if (reason != REASON_TRANSFER_COMPLETE_STOPPED) return;
+  int16_t blocks = 0;
+  while (streamQueue.collect(source) != -1) blocks++;
+  if (blocks > 1) streamCoalesced++;
+}
+
+// Main loop side -> reads whatever is queued, in spans of up to one block
+static void streamRead(uint32_t maxSamples) {
+  uint16_t *samples;
+  uint32_t count;
+  while (maxSamples > 0 && (count = streamQueue.peekSamples(samples)) > 0) {
+    count = MIN(count, maxSamples);
+    for (uint32_t i = 0; i < count; i++) {
+      if (samples[i] != streamExpected++) streamMismatches++;
+    }
+    streamSamples += count;
+    maxSamples -= count;
+    streamQueue.commitSamples(count);
+  }
+}
+
+static void benchStream(TransferChannel &channel) {
+  printf("stream blocks from writeback (%d x %d samples, late irqs)\n", BENCH_STREAM_BLOCKS,
+    BENCH_STREAM_BLOCK_LENGTH);
+  static volatile uint16_t result;  // Stands in for ADC RESULT
+  static TransferDescriptor blocks[BENCH_STREAM_BLOCKS];
+  TransferDescriptor *blockPtrs[BENCH_STREAM_BLOCKS];
+
+  for (int16_t i = 0; i < BENCH_STREAM_BLOCKS; i++) {
+    blocks[i].setAction(ACTION_BLOCK_INTERRUPT)
+      .setDataSize(2)
+      .setIncrementConfig(false, true)
+      .setTransferAmount(BENCH_STREAM_BLOCK_LENGTH)
+      .setDestination(streamBuffer + i * BENCH_STREAM_BLOCK_LENGTH, true)
+      .setSource((uint32_t)&result, false);
+    blockPtrs[i] = &blocks[i];
+  }
+  channel.settings.setTriggerAction(ACTION_TRANSFER_BURST)
+    .setBurstLength(1)
+    .setExternalTrigger(BENCH_TRIGGER)
+    .setCallbackFunction(streamCallback)
+    .setCallbackConfig(true, true, false)
+    .setDescriptorsLooped(true, false);
+  channel.setDescriptors(blockPtrs, BENCH_STREAM_BLOCKS, false, false);
+  channel.enableExternalTrigger();
+  channel.enable();
+  streamQueue.reset(streamBuffer, BENCH_STREAM_BLOCK_LENGTH);
+  streamExpected = 0;
+  streamSamples = 0;
+  streamMismatches = 0;
+  streamCoalesced = 0;
+
+  const uint32_t total = (uint32_t)BENCH_STREAM_WRAPS * BENCH_STREAM_BLOCKS
+    * BENCH_STREAM_BLOCK_LENGTH;
+  uint32_t seed = 12345;
+  uint32_t maskLeft = 0;
+  uint32_t readAt = 1;
+  for (uint32_t fed = 0; fed < total; fed++) {
+    if (maskLeft == 0) {
+      __enable_irq();
+      seed = seed * 1103515245u + 12345u;
+      maskLeft = (seed >> 16) % (BENCH_STREAM_MAX_MASK + 1);
+      if (maskLeft > 0) __disable_irq();
+    } else {
+      maskLeft--;
+    }
+    result = (uint16_t)fed;
+    simDMACTrigger(BENCH_TRIGGER);
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+    if (streamQueue.samplesAvailable() >= readAt) {
+      streamRead(streamQueue.samplesAvailable());
+      seed = seed * 1103515245u + 12345u;
+      readAt = 1 + (seed >> 16) % BENCH_STREAM_READ_LAG;
+    }
+  }
+  __enable_irq();
+  streamRead(total);
+
+  printf("  %lu wraps -> %lu samples read, %lu dropped, %lu overruns, %lu irqs covered > 1 block\n",
+    (unsigned long)BENCH_STREAM_WRAPS, (unsigned long)streamSamples,
+    (unsigned long)(total - streamSamples), (unsigned long)streamQueue.getOverruns(),
+    (unsigned long)streamCoalesced);
+  check(streamSamples == total && streamMismatches == 0, "every sample once, in order");
+  check(streamQueue.getOverruns() == 0, "no overruns");
+  check(streamCoalesced > 0, "late irqs covered several blocks");
+
+
+  // Reader stops for 2 laps -> queue holds what the DMAC has not lapped, the rest is counted
+  const uint32_t lapped = 2 * BENCH_STREAM_BLOCKS * BENCH_STREAM_BLOCK_LENGTH;
+  uint32_t before = streamSamples;
+  for (uint32_t fed = 0; fed < lapped; fed++) {
+    result = (uint16_t)(total + fed);
+    simDMACTrigger(BENCH_TRIGGER);
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  }
+  uint32_t queued = streamQueue.samplesAvailable();
+  streamRead(lapped);
+  check(queued == (BENCH_STREAM_BLOCKS - 1) * BENCH_STREAM_BLOCK_LENGTH
+    && streamSamples - before == queued && queued + streamQueue.getOverruns() == lapped,
+    "stopped reader -> lapped blocks counted as overruns");
+
+  channel.disable(true);
+  channel.disableExternalTrigger();
+  channel.settings.setDescriptorsLooped(false, false);
+}
+
+// ADC buffer swap (setBuffer / setBufferLength) -> single shot descriptor reloaded by the ADC's
+// own loader must move the next samples into the new buffer, none into the old one
+static void benchBufferSwap(TransferChannel &channel) {
+  printf("single shot buffer swap\n");
+  static volatile uint16_t result;  // Stands in for ADC RESULT
+  static uint16_t oldBuffer[BENCH_SWAP_LENGTH];
+  static uint16_t newBuffer[2 * BENCH_SWAP_LENGTH];
+  static TransferDescriptor single;
+  single.setAction(ACTION_SUSPEND)
+    .setDataSize(2)
+    .setIncrementConfig(false, true)
+    .setSource((uint32_t)&result, false);
+  channel.settings.setTriggerAction(ACTION_TRANSFER_BURST)
+    .setBurstLength(1)
+    .setExternalTrigger(BENCH_TRIGGER)
+    .setCallbackFunction(countCallback)
+    .setCallbackConfig(true, true, false)
+    .setDescriptorsLooped(false, false);
+
+  const uint16_t lengths[2] = { BENCH_SWAP_LENGTH, 2 * BENCH_SWAP_LENGTH };
+  uint16_t *buffers[2] = { oldBuffer, newBuffer };
+  memset(oldBuffer, 0, sizeof(oldBuffer));
+  for (int16_t pass = 0; pass < 2; pass++) {
+    memset(newBuffer, 0, sizeof(newBuffer));
+    check(ADCLoadBuffer(channel, single, buffers[pass], lengths[pass]), "buffer loaded");
+    channel.enableExternalTrigger();
+    channel.enable();
+    for (uint16_t i = 0; i < lengths[pass]; i++) {
+      result = 1000 * (pass + 1) + i;
+      simDMACTrigger(BENCH_TRIGGER);
+      simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+    }
+    channel.disable(true);
+    channel.disableExternalTrigger();
+  }
+  bool filled = true;
+  for (uint16_t i = 0; i < 2 * BENCH_SWAP_LENGTH; i++) {
+    if (newBuffer[i] != 2000 + i) filled = false;
+    if (i < BENCH_SWAP_LENGTH && oldBuffer[i] != 1000 + i) filled = false;
+  }
+  check(filled, "resized buffer filled, old one left alone");
+  check(!ADCLoadBuffer(channel, single, nullptr, BENCH_SWAP_LENGTH), "no buffer refused");
+}
+
+// Pipe style hold -> block 1 invalid while "USB" reads it, DMAC fills the others, stops on it
+// (FERR) instead of overwriting it & carries on into it once released
+static volatile uint32_t holdErrors = 0;
+
+static void holdCallback(DMA_CALLBACK_REASON reason, TransferChannel &source,
+  int16_t descriptorIndex) {
+  if (reason == REASON_ERROR && source.getError() == ERROR_DMA_DESCRIPTOR) holdErrors++;
+}
+
+static void benchHeldBlock(TransferChannel &channel) {
+  printf("held stream block\n");
+  static volatile uint16_t result;
+  static TransferDescriptor blocks[BENCH_STREAM_BLOCKS];
+  TransferDescriptor *blockPtrs[BENCH_STREAM_BLOCKS];
+  const uint32_t ring = BENCH_STREAM_BLOCKS * BENCH_STREAM_BLOCK_LENGTH;
+
+  for (int16_t i = 0; i < BENCH_STREAM_BLOCKS; i++) {
+    blocks[i].setAction(ACTION_BLOCK_INTERRUPT)
+      .setDataSize(2)
+      .setIncrementConfig(false, true)
+      .setTransferAmount(BENCH_STREAM_BLOCK_LENGTH)
+      .setDestination(streamBuffer + i * BENCH_STREAM_BLOCK_LENGTH, true)
+      .setSource((uint32_t)&result, false);
+    blockPtrs[i] = &blocks[i];
+  }
+  channel.settings.setTriggerAction(ACTION_TRANSFER_BURST)
+    .setBurstLength(1)
+    .setExternalTrigger(BENCH_TRIGGER)
+    .setCallbackFunction(holdCallback)
+    .setCallbackConfig(true, true, false)
+    .setDescriptorsLooped(true, false);
+  channel.setDescriptors(blockPtrs, BENCH_STREAM_BLOCKS, false, false);
+  channel.enableExternalTrigger();
+  channel.enable();
+  holdErrors = 0;
+
+  // First lap, then hold block 1 just after the DMAC left it
+  uint32_t fed = 0;
+  for (; fed < ring + 2 * BENCH_STREAM_BLOCK_LENGTH; fed++) {
+    result = (uint16_t)fed;
+    simDMACTrigger(BENCH_TRIGGER);
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  }
+  check(channel.setDescriptorValid(1, false), "block held");
+
+  // DMAC has blocks 2, 3 & 0 left before it is back @ the held one
+  for (uint32_t i = 0; i < ring; i++, fed++) {
+    result = (uint16_t)fed;
+    simDMACTrigger(BENCH_TRIGGER);
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  }
+  uint16_t *held = streamBuffer + BENCH_STREAM_BLOCK_LENGTH;
+  check(holdErrors == 1 && channel.getStatus() == DMA_CHANNEL_SUSPENDED,
+    "stalled on the held block");
+  check(held[0] == ring + BENCH_STREAM_BLOCK_LENGTH
+    && held[BENCH_STREAM_BLOCK_LENGTH - 1] == ring + 2 * BENCH_STREAM_BLOCK_LENGTH - 1,
+    "held block not overwritten");
+
+  // Release -> next sample goes into the held block
+  channel.setDescriptorValid(1, true);
+  channel.resume();
+  result = 0xBEEF;
+  simDMACTrigger(BENCH_TRIGGER);
+  simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  check(held[0] == 0xBEEF, "stream resumes into the released block");
+
+  channel.disable(true);
+  channel.disableExternalTrigger();
+  channel.settings.setDescriptorsLooped(false, false);
+}
+
+// Event input -> one block per strobe, stands in for an upstream channel's block event (EVSYS)
+static void benchEventInput() {
+  printf("event input\n");
+  DMAChannelRequest request = { 1, SUBSYSTEM_USER, CLASS_NORMAL, TRIGGER_SOFTWARE, 0, 
+    false, true };
+  TransferChannel *channel = DMAUtility::allocateChannel(request);
+  check(channel != nullptr && channel->channelIndex < DMA_EVENT_INPUT_CHANNELS, 
+    "allocated channel w event input");
+  if (channel == nullptr) return;
+
+  memset(destination, 0, sizeof(destination));
+  buildChain(ACTION_NONE);
+  channel->settings.setTriggerAction(ACTION_TRANSFER_BLOCK)
+    .setEventInput(EVENT_ACTION_TRIGGER);
+  channel->setDescriptors(chainPtrs, BENCH_CHAIN_LENGTH, false, false);
+  channel->enable();
+
+  for (int16_t i = 0; i < BENCH_CHAIN_LENGTH; i++) {
+    simDMACEvent(channel->channelIndex);
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+  }
+  check(memcmp(destination, source, BENCH_BLOCK_BYTES * BENCH_CHAIN_LENGTH) == 0,
+    "event triggered blocks");
+  DMA.freeChannel(channel);
+}
+
+// Two user channels linked block -> block while ADC holds its reservation on channels 0 - 3.
+// No EVSYS model -> the bench routes the source's block event to the target itself.
+static void benchEventChain() {
+  printf("event chain (user channels)\n");
+  DMAChannelRequest sourceRequest = { 2, SUBSYSTEM_USER, CLASS_NORMAL, TRIGGER_SOFTWARE, 0,
+    true, false };
+  DMAChannelRequest targetRequest = { 2, SUBSYSTEM_USER, CLASS_NORMAL, TRIGGER_SOFTWARE, 0,
+    false, true };
+  TransferChannel *first = DMAUtility::allocateChannel(sourceRequest);
+  TransferChannel *second = DMAUtility::allocateChannel(targetRequest);
+  check(first != nullptr && first->channelIndex < DMA_EVENT_OUTPUT_CHANNELS,
+    "user channel w event output");
+  check(second != nullptr && second->channelIndex < DMA_EVENT_INPUT_CHANNELS,
+    "user channel w event input");
+  if (first == nullptr || second == nullptr) {
+    DMA.freeChannel(first);
+    DMA.freeChannel(second);
+    return;
+  }
+  memset(destination, 0, sizeof(destination));
+  buildChain(ACTION_NONE);
+  first->setDescriptors(chainPtrs, 2, false, false);
+  second->setDescriptors(chainPtrs + 2, 2, false, false);
+  first->settings.setTriggerAction(ACTION_TRANSFER_BLOCK)
+    .setEventOutput(EVENT_OUTPUT_BLOCK);
+  second->settings.setTriggerAction(ACTION_TRANSFER_BLOCK)
+    .setEventInput(EVENT_ACTION_TRIGGER);
+  check(first->getError() == ERROR_NONE && second->getError() == ERROR_NONE, "channels linked");
+  first->enable();
+  second->enable();
+
+  for (int16_t i = 0; i < 2; i++) {
+    first->trigger();
+    simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+    if (DMAC->Channel[first->channelIndex].CHEVCTRL.bit.EVOE) {
+      simDMACEvent(second->channelIndex);
+      simDMACRunUntilIdle(BENCH_TIMEOUT_CYCLES);
+    }
+  }
+  check(memcmp(destination, source, BENCH_BLOCK_BYTES * BENCH_CHAIN_LENGTH) == 0,
+    "target moved one block per source block");
+  DMA.freeChannel(first);
+  DMA.freeChannel(second);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> ASYNC COPY, CHECKSUM & TUNING
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void benchAsync() {
+  printf("copyAsync / fillAsync (%d bytes)\n", BENCH_ASYNC_BYTES);
+  fillPattern(source, BENCH_ASYNC_BYTES + 8, 3);
+
+  // Aligned copy -> word beats
+  memset(destination, 0, sizeof(destination));
+  uint64_t startCycles = simCycles();
+  DMAHandle handle = DMAUtility::copyAsync(destination, source, BENCH_ASYNC_BYTES);
+  check(handle.slot >= 0 && DMAUtility::wait(handle, 100000), "aligned copy finished");
+  uint64_t alignedCycles = simCycles() - startCycles;
+  check(memcmp(destination, source, BENCH_ASYNC_BYTES) == 0, "aligned copy data");
+
+  // Odd offsets -> byte beats
+  memset(destination, 0, sizeof(destination));
+  startCycles = simCycles();
+  handle = DMAUtility::copyAsync(destination + 1, source + 3, BENCH_ASYNC_BYTES - 5);
+  check(handle.slot >= 0 && DMAUtility::wait(handle, 100000), "unaligned copy finished");
+  uint64_t unalignedCycles = simCycles() - startCycles;
+  check(memcmp(destination + 1, source + 3, BENCH_ASYNC_BYTES - 5) == 0, "unaligned copy data");
+  check(destination[0] == 0 && destination[BENCH_ASYNC_BYTES - 4] == 0, "copy stays in bounds");
+
+  startCycles = simCycles();
+  handle = DMAUtility::fillAsync(destination, 0x5A, BENCH_ASYNC_BYTES);
+  check(handle.slot >= 0 && DMAUtility::wait(handle, 100000), "fill finished");
+  uint64_t fillCycles = simCycles() - startCycles;
+  bool filled = true;
+  for (uint32_t i = 0; i < BENCH_ASYNC_BYTES; i++) filled &= (destination[i] == 0x5A);
+  check(filled, "fill data");
+
+  printf("  aligned copy -> %llu sim cycles\n", (unsigned long long)alignedCycles);
+  printf("  unaligned copy -> %llu sim cycles\n", (unsigned long long)unalignedCycles);
+  printf("  fill -> %llu sim cycles\n", (unsigned long long)fillCycles);
+}
+
+// Software reference first -> checked against the catalogue check values of the engine's
+// polynomials ("123456789"), so engine model & reference can not share a wrong constant
+static void benchChecksum() {
+  printf("checksum engine\n");
+  const char *vector = "123456789";
+  check(softCRC16(vector, 9) == 0x29B1, "softCRC16 is CRC-16/CCITT-FALSE");
+  check(softCRC32Final(softCRC32(vector, 9)) == 0xCBF43926ul, "softCRC32 is CRC-32/IEEE");
+  check(softCRC16(vector + 4, 5, softCRC16(vector, 4)) == 0x29B1
+    && softCRC32Final(softCRC32(vector + 4, 5, softCRC32(vector, 4))) == 0xCBF43926ul,
+    "soft CRCs continue over split data");
+
+  static ChecksumGen checksum(0);
+  check(checksum.begin(), "checksum channel");
+  check(checksum.selfTest(), "CRC16 & CRC32 match software reference");
+}
+
+static void benchTuning() {
+  printf("transfer tuning (%d bytes)\n", BENCH_TUNING_BYTES);
+  fillPattern(source, BENCH_TUNING_BYTES, 5);
+
+  DMATuning tuning = DMAUtility::tune((uint32_t)destination, (uint32_t)source, BENCH_TUNING_BYTES);
+  check(tuning.beatSize == 4 && tuning.burstLength == 16 && tuning.threshold == 8, "tune picks widest");
+  tuning = DMAUtility::tune((uint32_t)destination + 1, (uint32_t)source, BENCH_TUNING_BYTES);
+  check(tuning.beatSize == 1, "tune falls back to byte beats");
+
+  DMATuningResult results[BENCH_TUNING_RESULTS];
+  memset(destination, 0, sizeof(destination));
+  int16_t count = DMAUtility::benchmarkTuning(destination, source, BENCH_TUNING_BYTES, results,
+    BENCH_TUNING_RESULTS);
+  check(count == BENCH_TUNING_RESULTS, "benchmark filled results");
+  check(memcmp(destination, source, BENCH_TUNING_BYTES) == 0, "benchmark data");
+  check(count > 0 && results[0].tuning.beatSize == 4 && results[0].tuning.burstLength == 16,
+    "fastest is word beats, 16 beat bursts");
+
+  for (int16_t i = 0; i < count; i++) {
+    printf("  beat %d, burst %d, threshold %d -> %lu cycles, %.1f bytes/us\n",
+      results[i].tuning.beatSize, results[i].tuning.burstLength, results[i].tuning.threshold,
+      (unsigned long)results[i].cycles, results[i].bytesPerMicro);
+  }
+}
+
+// end() -> begin() must start from nothing -> no channel allocated, whole budget free
+static void benchRestart() {
+  printf("end / begin\n");
+  DMAChannelRequest request = { 0, SUBSYSTEM_USER, CLASS_NORMAL, TRIGGER_SOFTWARE, 1000000,
+    false, false };
+  TransferChannel *channel = DMAUtility::allocateChannel(request);
+  check(channel != nullptr && DMA.bandwidthFree() < DMA_BANDWIDTH_BUDGET, "budget booked");
+
+  DMA.end();
+  DMA.begin();
+  DMAChannelUsage table[DMA_MAX_CHANNELS];
+  int16_t count = DMA.getUtilization(table, DMA_MAX_CHANNELS);
+  bool clean = (count == DMA_MAX_CHANNELS);
+  for (int16_t i = 0; i < count; i++) {
+    if (table[i].allocated || table[i].request.bytesPerSecond != 0) clean = false;
+  }
+  check(clean && DMA.bandwidthFree() == DMA_BANDWIDTH_BUDGET, "end() frees every channel");
+
+  channel = DMAUtility::allocateChannel(request);
+  check(channel != nullptr, "channel allocated after restart");
+  DMA.freeChannel(channel);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// SECTION -> MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main() {
+  simResetCore();
+  simDMACReset();
+  DMA.begin();
+
+  DMAChannelRequest request = { 0, SUBSYSTEM_USER, CLASS_NORMAL, TRIGGER_SOFTWARE, 0,
+    false, false };
+  TransferChannel *channel = DMAUtility::allocateChannel(request);
+  if (channel == nullptr) {
+    printf("no channel\n");
+    return 1;
+  }
+  benchSetup(*channel);
+  benchStaticChain(*channel);
+  benchTransaction(*channel);
+  benchISR(*channel);
+  benchLiveUpdate(*channel);
+  benchError(*channel);
+  benchTriggerCapture(*channel);
+  benchStream(*channel);
+  benchBufferSwap(*channel);
+  benchHeldBlock(*channel);
+  benchEventInput();
+  benchEventChain();
+  benchAsync();
+  benchChecksum();
+  benchTuning();
+  benchRestart();
+  DMA.end();
+
+  benchCOM();
+  benchFrame();
+  benchRing();
+  printf("%s (%lu failures, %llu sim cycles total)\n", failures ? "FAILED" : "OK",
+    (unsigned long)failures, (unsigned long long)simCycles());
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> FRAME BENCH (NATIVE ENV ONLY)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Encoder -> byte stream -> reference decoder, no USB in between. Stream is pushed in odd sized
+// chunks so frames straddle push() calls like they straddle host reads.
+
+#include <Arduino.h>
+#include <FRAME.h>
+#include "Bench.h"
+
+#define BENCH_FRAME_STREAM_BYTES 8192
+#define BENCH_FRAME_PAYLOAD 256
+#define BENCH_FRAME_ROUNDS 8
+#define BENCH_FRAME_CHUNK 37
+
+static __attribute__((__aligned__(4))) uint8_t payloads[BENCH_FRAME_ROUNDS][BENCH_FRAME_PAYLOAD];
+static uint8_t stream[BENCH_FRAME_STREAM_BYTES];
+static uint8_t decodeBuffer[BENCH_FRAME_PAYLOAD + FRAME_OVERHEAD];
+
+// Returns frames decoded w a valid payload that matches payloads[] (by sequence)
+static int16_t decodeStream(FrameDecoder &decoder, uint32_t length) {
+  int16_t matched = 0;
+  uint32_t offset = 0;
+  while (offset < length) {
+    uint32_t chunk = MIN((uint32_t)BENCH_FRAME_CHUNK, length - offset);
+    uint32_t taken = decoder.push(stream + offset, chunk);
+    offset += taken;
+    while (decoder.available()) {
+      const FrameHeader *header = decoder.getHeader();
+      if (decoder.getPayloadValid() && header->sequence < BENCH_FRAME_ROUNDS
+      && memcmp(decoder.getPayload(), payloads[header->sequence], header->payloadLength) == 0) {
+        matched++;
+      }
+      decoder.next();
+    }
+    if (taken == 0 && !decoder.available()) break;
+  }
+  return matched;
+}
+
+static void benchFrameRoundTrip(CRC_MODE mode, const char *name) {
+  FrameEncoder encoder(2, mode);
+  FrameDecoder decoder(decodeBuffer, sizeof(decodeBuffer));
+  uint32_t length = 0;
+  for (int16_t i = 0; i < BENCH_FRAME_ROUNDS; i++) {
+    int32_t written = encoder.encode(payloads[i], BENCH_FRAME_PAYLOAD, stream + length,
+      sizeof(stream) - length);
+    check(written == BENCH_FRAME_PAYLOAD + FRAME_OVERHEAD, "frame encoded");
+    if (written > 0) length += written;
+  }
+  int16_t matched = decodeStream(decoder, length);
+  printf("  %s -> %d / %d frames, %lu gaps, %lu bytes skipped\n", name, matched,
+    BENCH_FRAME_ROUNDS, (unsigned long)decoder.sequenceGaps(),
+    (unsigned long)decoder.bytesSkipped());
+  check(matched == BENCH_FRAME_ROUNDS && decoder.framesDecoded() == BENCH_FRAME_ROUNDS,
+    "round trip");
+  check(decoder.sequenceGaps() == 0 && decoder.payloadErrors() == 0
+    && decoder.headerErrors() == 0, "clean stream has no errors");
+}
+
+// Frame 3 never reaches the stream -> one gap, one frame lost
+static void benchFrameGap() {
+  FrameEncoder encoder(3);
+  FrameDecoder decoder(decodeBuffer, sizeof(decodeBuffer));
+  uint8_t dropped[BENCH_FRAME_PAYLOAD + FRAME_OVERHEAD];
+  uint32_t length = 0;
+  for (int16_t i = 0; i < BENCH_FRAME_ROUNDS; i++) {
+    if (i == 3) {
+      encoder.encode(payloads[i], BENCH_FRAME_PAYLOAD, dropped, sizeof(dropped));
+      continue;
+    }
+    length += encoder.encode(payloads[i], BENCH_FRAME_PAYLOAD, stream + length,
+      sizeof(stream) - length);
+  }
+  int16_t matched = decodeStream(decoder, length);
+  check(matched == BENCH_FRAME_ROUNDS - 1, "frames around the gap decoded");
+  check(decoder.sequenceGaps() == 1 && decoder.framesLost() == 1, "sequence gap counted");
+}
+
+// Payload byte flipped -> frame still delivered but flagged, header byte flipped -> resync
+static void benchFrameCorrupt() {
+  FrameEncoder encoder(4, CRC_32);
+  FrameDecoder decoder(decodeBuffer, sizeof(decodeBuffer));
+  const uint32_t frameBytes = BENCH_FRAME_PAYLOAD + FRAME_OVERHEAD;
+  uint32_t length = 0;
+  for (int16_t i = 0; i < BENCH_FRAME_ROUNDS; i++) {
+    length += encoder.encode(payloads[i], BENCH_FRAME_PAYLOAD, stream + length,
+      sizeof(stream) - length);
+  }
+  stream[1 * frameBytes + FRAME_HEADER_SIZE + 10] ^= 0x40;  // Frame 1 payload
+  stream[5 * frameBytes + 9] ^= 0x01;                       // Frame 5 sequence (header CRC)
+
+  int16_t matched = decodeStream(decoder, length);
+  check(decoder.payloadErrors() == 1, "bad payload CRC flagged");
+  check(decoder.headerErrors() >= 1 && decoder.framesDecoded() == BENCH_FRAME_ROUNDS - 1,
+    "bad header skipped");
+  check(matched == BENCH_FRAME_ROUNDS - 2, "other frames intact");
+  check(decoder.sequenceGaps() == 1 && decoder.framesLost() == 1,
+    "skipped frame shows up as a gap");
+}
+
+void benchFrame() {
+  printf("frame encode -> decode\n");
+  for (int16_t i = 0; i < BENCH_FRAME_ROUNDS; i++) {
+    fillPattern(payloads[i], BENCH_FRAME_PAYLOAD, 3 * i + 1);
+  }
+  benchFrameRoundTrip(CRC_16, "CRC16");
+  benchFrameRoundTrip(CRC_32, "CRC32");
+  benchFrameGap();
+  benchFrameCorrupt();
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///// FILE -> RING BUFFER BENCH (NATIVE ENV ONLY)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Hammers RingBuffer from two host threads, producer stands in for the ISR & never waits. Every
+// element is a running count, so the consumer sees any lost, repeated or torn element.
+
+#include <RingBuffer.h>
+#include <atomic>
+#include <thread>
+#include "Bench.h"
+
+#define BENCH_RING_LENGTH 256
+#define BENCH_RING_ELEMENTS 2000000ul
+#define BENCH_RING_MAX_CHUNK 37
+
+static RingBuffer<uint32_t, BENCH_RING_LENGTH> ring;
+static std::atomic<bool> producerDone(false);
+
+// Writes what fits -> count only moves by what the ring took, so the stream stays gapless
+static void produce() {
+  uint32_t chunk[BENCH_RING_MAX_CHUNK];
+  uint32_t next = 0;
+  uint32_t seed = 7;
+  while (next < BENCH_RING_ELEMENTS) {
+    seed = seed * 1103515245u + 12345u;
+    uint32_t count = MIN(1 + (seed >> 16) % BENCH_RING_MAX_CHUNK,
+      (uint32_t)(BENCH_RING_ELEMENTS - next));
+    for (uint32_t i = 0; i < count; i++) chunk[i] = next + i;
+    uint32_t written = ring.write(chunk, count);
+    next += written;
+    if (written < count) std::this_thread::yield();  // Full -> let the consumer run (1 core)
+  }
+  producerDone.store(true, std::memory_order_release);
+}
+
+void benchRing() {
+  printf("ring buffer (2 threads, %lu elements)\n", (unsigned long)BENCH_RING_ELEMENTS);
+  ring.clear();
+  producerDone.store(false);
+
+  uint64_t start = hostNanos();
+  std::thread producer(produce);
+  uint32_t expected = 0;
+  uint32_t mismatches = 0;
+  uint32_t seed = 3;
+  while (expected < BENCH_RING_ELEMENTS) {
+    uint32_t *span;
+    uint32_t count = ring.peekContiguous(span);
+    if (count == 0) {
+      if (producerDone.load(std::memory_order_acquire) && ring.available() == 0) break;
+      std::this_thread::yield();
+      continue;
+    }
+    // Commit part of the span at times -> next peek starts mid span
+    seed = seed * 1103515245u + 12345u;
+    if ((seed >> 16) % 4 == 0) count = 1 + (seed >> 16) % count;
+    for (uint32_t i = 0; i < count; i++) {
+      if (span[i] != expected + i) mismatches++;
+    }
+    expected += count;
+    ring.commit(count);
+  }
+  producer.join();
+  uint64_t nanos = hostNanos() - start;
+
+  printf("  %lu received, %lu out of order, %lu refused (full), %.1f ns per element (host)\n",
+    (unsigned long)expected, (unsigned long)mismatches, (unsigned long)ring.getOverruns(),
+    (double)nanos / BENCH_RING_ELEMENTS);
+  check(expected == BENCH_RING_ELEMENTS && mismatches == 0, "every element once, in order");
+  check(ring.available() == 0, "ring drained");
+}